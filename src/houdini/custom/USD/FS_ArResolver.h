@@ -31,6 +31,9 @@
  *     The native resolver from Pixar uses PXR_AR_DEFAULT_SEARCH_PATH
  *   to search files. This feature is inherited to this plugin, but
  *   only works when FS_Reader return an invalid path.
+ *     SOP layer identifiers ("op:/...sop") are never written to disk.
+ *   They are assigned a placeholder resolved path, and OpenAsset serves
+ *   the identifier from memory.
  *
  */
 
@@ -45,6 +48,7 @@
 #include <UT/UT_Lock.h>
 #include <UT/UT_ConcurrentHashMap.h>
 #include <UT/UT_ThreadSpecificValue.h>
+#include <SYS/SYS_AtomicInt.h>
 
 #include <pxr/pxr.h>
 #include <pxr/usd/ar/resolver.h>
@@ -79,6 +83,12 @@ public:
     // this function will return the expected path of temp file.
     std::string		 ComputeDiskPath(const std::string& path);
 
+    // Returns the total number of bytes served from memory for SOP layer
+    // identifiers which would otherwise have been written to (and read back
+    // from) temporary files on disk.
+    exint		 GetInMemoryFetchBytes() const
+			 { return myInMemoryFetchBytes.relaxedLoad(); }
+
     // ArResolver overrides
     virtual void	 ConfigureResolverForAsset(
 				const std::string& path) override;
@@ -162,15 +172,21 @@ private:
     // Types for thread-safe fetching
     struct FetchItem : public UT_IntrusiveRefCounter<FetchItem>
     {
-	FetchItem(UT_String ide, UT_String path) : 
+	FetchItem(UT_String ide, UT_String path, bool inmemory = false) : 
 	    myIdentifier(ide), myFetchPath(path),
-	    myHasFetched(false), myFetchedSuccessfully(false) {} 
+	    myFetchTime(0.0),
+	    myHasFetched(false), myFetchedSuccessfully(false),
+	    myInMemory(inmemory) {} 
 
 	UT_Lock		 myLock;
 	UT_StringHolder	 myIdentifier;
 	UT_StringHolder	 myFetchPath;
+	double		 myFetchTime;
 	bool		 myHasFetched;
 	bool		 myFetchedSuccessfully;
+	// In-memory items never create a file at myFetchPath. Their
+	// contents (the identifier itself) are served from OpenAsset.
+	bool		 myInMemory;
     };
     typedef UT_IntrusivePtr<FetchItem> FetchPtr;
     typedef UT_ConcurrentHashMap<UT_StringHolder, FetchPtr> FetchMap;
@@ -178,6 +194,7 @@ private:
     // Private members
     TLSCacheScopeDataArray	 myTLSCacheScopeDataArray;
     FetchMap			 myFetchMap;
+    SYS_AtomicInt64		 myInMemoryFetchBytes;
     std::vector<std::string>	 mySearchPath;
     std::unique_ptr<ArResolver>	 myFallbackResolver;
 };
@@ -22,6 +22,9 @@
 #include <GU/GU_DetailHandle.h>
 #include <UT/UT_UniquePtr.h>
 #include <UT/UT_Array.h>
+#include <UT/UT_Lock.h>
+#include <UT/UT_Map.h>
+#include <set>
 
 PXR_NAMESPACE_OPEN_SCOPE
 
@@ -45,15 +48,70 @@ public:
     /// store for editing so methods that modify the file are not supported.
     virtual bool Open(const std::string &filePath) override;
 
+    /// Totals of the attribute memory shared with the source geometry and
+    /// the memory that had to be copied out of it when building this layer.
+    void		 getAttribMemory(exint &shared_bytes,
+				exint &copied_bytes) const;
+
+    /// When opened with the "sequence" ($F file name pattern) and
+    /// "framerange" ("start end [inc]") arguments, the file is treated as
+    /// the first frame of a geometry sequence. Every frame in the range is
+    /// presented as a time sample, and the other frames are only loaded
+    /// when a value is queried at their time. The prim hierarchy comes from
+    /// the first frame.
+    virtual bool Has(const SdfPath &id,
+		     const TfToken &fieldName,
+		     SdfAbstractDataValue *value) const override;
+    virtual bool Has(const SdfPath &id,
+		     const TfToken &fieldName,
+		     VtValue *value = NULL) const override;
+    virtual std::set<double> ListAllTimeSamples() const override;
+    virtual std::set<double> ListTimeSamplesForPath(
+	const SdfPath &id) const override;
+    virtual bool GetBracketingTimeSamples(double time,
+	double *tLower, double *tUpper) const override;
+    virtual size_t GetNumTimeSamplesForPath(const SdfPath &id) const override;
+    virtual bool GetBracketingTimeSamplesForPath(const SdfPath &id,
+	double time, double *tLower, double *tUpper) const override;
+    virtual bool QueryTimeSample(const SdfPath &id,
+	double time, SdfAbstractDataValue *value) const override;
+    virtual bool QueryTimeSample(const SdfPath &id,
+	double time, VtValue *value) const override;
+
 protected:
 			 GEO_FileData();
     virtual		~GEO_FileData();
 
 private:
+    bool		 isSequence() const
+			 { return !mySequenceFrames.empty(); }
+    bool		 isSequenceProp(const SdfPath &id) const;
+    bool		 initSequence(const std::string &filePath);
+    double		 getSequenceSourceFrame(double frame) const;
+    GEO_FileDataRefPtr	 getSequenceFrame(double frame) const;
+    void		 shareSequenceTopology(GEO_FileData &framedata) const;
+    bool		 getSequenceSamples(const SdfPath &id,
+				const GEO_FileFieldValue &value) const;
+
     GEO_FilePrim			*myLayerInfoPrim;
     SdfFileFormat::FileFormatArguments	 myCookArgs;
     bool				 mySaveSampleFrame;
 
+    // Geometry sequence data. The frames other than our own sample frame
+    // are loaded on demand into their own GEO_FileData, and a small number
+    // of the most recently used ones are kept around. Frames that use the
+    // same file as an earlier frame are answered from that frame's data.
+    // Topology that matches the last loaded frame shares that frame's
+    // property source.
+    std::set<double>			 mySequenceFrames;
+    UT_Map<double, double>		 mySequenceSourceFrames;
+    std::string				 mySequencePattern;
+    mutable UT_Map<double, GEO_FileDataRefPtr> mySequenceData;
+    mutable UT_Array<double>		 mySequenceDataOrder;
+    mutable UT_Map<SdfPath, std::pair<VtValue, GEO_FilePropSourceHandle> >
+					 mySequenceTopology;
+    mutable UT_Lock			 mySequenceLock;
+
     friend class GEO_FilePrim;
 };
 
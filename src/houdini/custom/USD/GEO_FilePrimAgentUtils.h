@@ -165,6 +165,7 @@ public:
 
     const GU_Agent &getAgent() const { return *myAgent; }
     const SdfPath &getDefinitionPath() const { return myDefinitionPath; }
+    void setDefinitionPath(const SdfPath &path) { myDefinitionPath = path; }
 
     static int getStaticPrimitiveType();
 
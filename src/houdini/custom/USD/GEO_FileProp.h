@@ -70,6 +70,14 @@ public:
 				 { return myCustomData; }
     bool			 copyData(const GEO_FileFieldValue &v) const;
 
+    // Access to the value source, so that identical values can be shared
+    // between the frames of a geometry sequence.
+    const GEO_FilePropSourceHandle &getPropSource() const
+				 { return myPropSource; }
+    void			 setPropSource(
+					const GEO_FilePropSourceHandle &src)
+				 { myPropSource = src; }
+
     // Add metadata or custom data to a property.
     // The "add" methods use emplace, and so do not replace existing values.
     void			 addMetadata(const TfToken &key,
@@ -19,11 +19,15 @@
  
 #include "pxr/pxr.h"
 #include "GEO_FileFieldValue.h"
+#include <GT/GT_DANumeric.h>
 #include <GT/GT_DataArray.h>
 #include <UT/UT_IntrusivePtr.h>
 #include <UT/UT_NonCopyable.h>
+#include <UT/UT_StringArray.h>
 #include <UT/UT_TBBSpinLock.h>
 #include <pxr/base/vt/array.h>
+#include <string>
+#include <vector>
 
 PXR_NAMESPACE_OPEN_SCOPE
 
@@ -37,6 +41,13 @@ public:
 			 { }
 
     virtual bool	 copyData(const GEO_FileFieldValue &value) = 0;
+
+    // Memory used by this source that is shared with the geometry it was
+    // built from, and memory that had to be copied out of that geometry.
+    virtual exint	 sharedBytes() const
+			 { return 0; }
+    virtual exint	 copiedBytes() const
+			 { return 0; }
 };
 
 typedef UT_IntrusivePtr<GEO_FilePropSource> GEO_FilePropSourceHandle;
@@ -142,13 +153,42 @@ public:
 			 GEO_FilePropAttribSource(
 				 const GT_DataArrayHandle &attrib)
 			     : myAttrib(attrib),
-			       myData(nullptr)
+			       myData(nullptr),
+			       myCopied(false)
 			 {
+			    const GT_Size	 tuple_size =
+				sizeof(T) / sizeof(ComponentT);
 			    GT_DataArrayHandle	 storage;
-                            myData = myAttrib->getArray<ComponentT>(myAttrib);
 
+			    // The VtArray reinterprets the data as an array
+			    // of T, so the tuple size has to match exactly.
+			    // Otherwise repack the data once into a buffer
+			    // of the right shape, padding with zeroes.
+			    if (myAttrib->getTupleSize() != tuple_size)
+			    {
+				GT_Size		 entries = myAttrib->entries();
+				GT_DANumeric<ComponentT> *packed =
+				    new GT_DANumeric<ComponentT>(
+					entries, tuple_size);
+
+				memset(packed->data(), 0,
+				    entries * tuple_size * sizeof(ComponentT));
+				for (GT_Offset i = 0; i < entries; ++i)
+				    myAttrib->import(i, packed->getData(i),
+					tuple_size);
+				myAttrib = packed;
+				myCopied = true;
+			    }
+
+			    // Paged or mismatched storage is flattened into a
+			    // single buffer here, once, and that buffer is
+			    // shared by every VtArray we hand out.
+                            myData = myAttrib->getArray<ComponentT>(storage);
 			    if (storage)
+			    {
 				myAttrib = storage;
+				myCopied = true;
+			    }
 			 }
 
     virtual bool	 copyData(const GEO_FileFieldValue &value)
@@ -180,6 +220,11 @@ public:
                             return value.Set(result);
 			 }
 
+    virtual exint	 sharedBytes() const
+			 { return myCopied ? 0 : size() * sizeof(T); }
+    virtual exint	 copiedBytes() const
+			 { return myCopied ? size() * sizeof(T) : 0; }
+
     GT_Size		 size() const
 			 { return myAttrib->entries(); }
     const T		*data() const
@@ -189,6 +234,7 @@ private:
     GT_DataArrayHandle		 myAttrib;
     const void			*myData;
     geo_AttribForeignSource	 myForeignSource;
+    bool			 myCopied;
 };
 
 template<>
@@ -198,17 +244,51 @@ class GEO_FilePropAttribSource<std::string, std::string> :
 public:
 			 GEO_FilePropAttribSource(
 				 const GT_DataArrayHandle &attrib)
-			     : myValue(attrib->entries())
+			     : myValue(attrib->entries()),
+			       myCopiedBytes(0)
 			 {
 			    exint	 length = attrib->entries();
 
-			    for (exint i = 0; i < length; ++i)
+			    if (attrib->getStringIndexCount() >= 0)
+			    {
+				// Indexed strings only need each unique string
+				// converted once, and the per element work is
+				// just a lookup into that table.
+				UT_StringArray		 strings;
+				UT_IntArray		 indices;
+				std::vector<std::string> table;
+
+				attrib->getIndexedStrings(strings, indices);
+				for (exint i = 0; i < strings.size(); ++i)
+				{
+				    if (indices(i) < 0)
+					continue;
+				    if (indices(i) >= (exint)table.size())
+					table.resize(indices(i) + 1);
+				    table[indices(i)] = strings(i).toStdString();
+				}
+				for (exint i = 0; i < length; ++i)
+				{
+				    GT_Offset	 idx = attrib->getStringIndex(i);
+
+				    if (idx >= 0 && idx < (exint)table.size())
+					myValue[i] = table[idx];
+				}
+			    }
+			    else
 			    {
-				const GT_String	str = attrib->getS(i);
+				for (exint i = 0; i < length; ++i)
+				{
+				    const GT_String	str = attrib->getS(i);
 
-				if (str)
-				    myValue[i] = str.toStdString();
+				    if (str)
+					myValue[i] = str.toStdString();
+				}
 			    }
+
+			    myCopiedBytes = length * sizeof(std::string);
+			    for (exint i = 0; i < length; ++i)
+				myCopiedBytes += myValue[i].size();
 			 }
 
     virtual bool	 copyData(const GEO_FileFieldValue &value)
@@ -216,6 +296,9 @@ public:
 			    return value.Set(myValue);
 			 }
 
+    virtual exint	 copiedBytes() const
+			 { return myCopiedBytes; }
+
     GT_Size		 size() const
 			 { return myValue.size(); }
     const std::string	*data() const
@@ -223,6 +306,7 @@ public:
 
 private:
     VtArray<std::string> myValue;
+    exint		 myCopiedBytes;
 };
 
 
@@ -55,6 +55,13 @@ PXR_NAMESPACE_OPEN_SCOPE
 // The gprim array can contain prims from several OBJ nodes. The obj nodes
 // provide a coordinate space and a set of options. We stash this stuff with
 // the prims in the prim array.
+//
+// The embedded geometry of the instances of a packed prim is refined in
+// parallel, with each instance recording into its own collector. The
+// recordings are replayed into the main collector in instance order so the
+// results are identical to a serial refine. GT is not allowed to thread the
+// refinement of a single detail, since that would make the order of added
+// prims (and so the generated names) non-deterministic.
 
 class GEO_FileRefinerCollector;
 class GT_PrimPointInstancer;
@@ -152,6 +159,11 @@ private:
         const SdfPath &pathPrefix, const UT_StringArray &pathAttrNames,
         const GT_PrimitiveHandle &src_prim,
         const GEO_AgentShapeInfo &agentShapeInfo = GEO_AgentShapeInfo());
+    GEO_FileRefiner createSubRefiner(
+        GEO_FileRefinerCollector &collector,
+        const SdfPath &pathPrefix, const UT_StringArray &pathAttrNames,
+        const GT_PrimitiveHandle &src_prim,
+        const GEO_AgentShapeInfo &agentShapeInfo = GEO_AgentShapeInfo());
 
     /// Creates or returns the point instancer for the given primitive path.
     UT_IntrusivePtr<GT_PrimPointInstancer>
@@ -241,6 +253,18 @@ public:
 
     ////////////////////////////////////////////////////////////////////////////
 
+    GEO_FileRefinerCollector() : m_recording(false) {}
+
+    // Record calls to add instead of processing them. The path handles
+    // returned by add initially hold placeholder paths, and are updated with
+    // the real paths when the recording is replayed.
+    void setRecording(bool recording) { m_recording = recording; }
+
+    // Process the calls recorded by another collector, in the order they
+    // were made. If this collector is also recording, the calls are simply
+    // appended to our recording.
+    void replay(const GEO_FileRefinerCollector &recording);
+
     GEO_PathHandle add( 
         const SdfPath&              path,
         bool                        addNumericSuffix,
@@ -261,6 +285,31 @@ public:
 
     // Map used to generate unique names for each prim
     std::map<SdfPath, NameInfo> m_names;
+
+private:
+    // A call to add made on a recording collector.
+    struct RecordedCall
+    {
+        SdfPath             path;
+        GEO_PathHandle      handle;
+        SdfPath             placeholder;
+        bool                addNumericSuffix;
+        GT_PrimitiveHandle  prim;
+        UT_Matrix4D         xform;
+        GA_DataId           topologyId;
+        TfToken             purpose;
+        GusdWriteCtrlFlags  writeCtrlFlags;
+        GEO_AgentShapeInfo  agentShapeInfo;
+    };
+
+    // Replace a placeholder prefix in path with the real path it maps to.
+    SdfPath resolvePlaceholder(const SdfPath &path) const;
+
+    bool                        m_recording;
+    std::vector<RecordedCall>   m_recordedCalls;
+
+    // Map from placeholder paths to the handles they were replayed into.
+    std::map<SdfPath, GEO_PathHandle> m_placeholderPaths;
 };
 
 PXR_NAMESPACE_CLOSE_SCOPE
@@ -17,16 +17,21 @@
 #ifndef __GUSD_SOP_USDUNPACK_H__
 #define __GUSD_SOP_USDUNPACK_H__
 
+#include <DEP/DEP_TimedMicroNode.h>
 #include <PRM/PRM_Template.h>
 #include <SOP/SOP_Node.h>
+#include <UT/UT_UniquePtr.h>
 
 #include "gusd/defaultArray.h"
+#include "gusd/GU_PackedUSD.h"
 #include "gusd/purpose.h"
 #include "gusd/USD_Traverse.h"
 
 #include <pxr/pxr.h>
 #include "pxr/usd/usd/prim.h"
 
+class GA_AttributeFilter;
+
 PXR_NAMESPACE_OPEN_SCOPE
 
 class GusdUSD_Traverse;
@@ -44,7 +49,7 @@ public:
 protected:
     SOP_UnpackUSD(OP_Network* net, const char* name, OP_Operator* op);
     
-    virtual ~SOP_UnpackUSD() {}
+    virtual ~SOP_UnpackUSD();
 
     virtual OP_ERROR    cookMySop(OP_Context& ctx) override;
 
@@ -52,6 +57,17 @@ protected:
 
     OP_ERROR            _Cook(OP_Context& ctx);
 
+    /** Run the traversal over the root prims, followed by a gprim
+        traversal if unpacking to polygons.*/
+    bool _TraverseForUnpack(const UT_String& traversal,
+                            const fpreal t,
+                            const UT_Array<UsdPrim>& rootPrims,
+                            const GusdDefaultArray<UsdTimeCode>& times,
+                            const GusdDefaultArray<GusdPurposeSet>& purposes,
+                            bool unpackToPolygons,
+                            UT_Array<GusdUSD_Traverse::PrimIndexPair>&
+                                traversedPrims);
+
     bool _Traverse(const UT_String& traversal,
                    const fpreal time,
                    const UT_Array<UsdPrim>& prims,
@@ -62,9 +78,33 @@ protected:
 
 
     /** Add micro nodes of all traversal parms as dependencies
-        to this node's data micro node.*/
+        to this node's data micro node, and all parms other than the
+        unpack time as dependencies of _unpackMicroNode.*/
     void                _AddTraversalParmDependencies();
 
+    /** Bring the geometry cached for incremental cooks up to date with
+        the traversed prims, and append it to gdp. Returns false if the
+        cached geometry can't be used, in which case nothing is appended.*/
+    bool                _AppendCachedGeometry(
+                            const GA_Range& rng,
+                            const UT_Array<GusdUSD_Traverse::PrimIndexPair>&
+                                traversedPrims,
+                            const GusdDefaultArray<UsdTimeCode>& times,
+                            const GA_AttributeFilter& filter,
+                            bool unpackToPolygons,
+                            const UT_String& primvarPattern,
+                            const UT_String& attributePattern,
+                            bool translateSTtoUV,
+                            const UT_StringRef& nonTransformingPrimvarPattern,
+                            GusdGU_PackedUSD::PivotLocation pivotloc);
+
+    /** Update the output of the last cook in place, when only the unpack
+        time has changed since then, re-unpacking only the prims that vary
+        with time. Returns false if the output has to be rebuilt, in which
+        case it may have been partially updated.*/
+    bool                _UpdateOutputInPlace(OP_Context& ctx,
+                                             const GU_Detail& input);
+
     virtual void        finishedLoadingNetwork(bool isChildCall) override;
 
     virtual void        syncNodeVersion(const char *old_version,
@@ -72,10 +112,17 @@ protected:
                                         bool *node_deleted) override;
 
 private:
+    struct _CookCache;
+
     UT_Array<PRM_Template>  _templates;
     PRM_Default             _tabs[2];
     const GA_Group*         _group;
 
+    /** Tracks changes to anything other than the unpack time that affects
+        the unpacked geometry, including reloads of the unpacked stages.*/
+    DEP_TimedMicroNode          _unpackMicroNode;
+    UT_UniquePtr<_CookCache>    _cookCache;
+
 public:
     static void         Register(OP_OperatorTable* table);
 };
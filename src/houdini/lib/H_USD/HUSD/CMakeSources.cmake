@@ -75,6 +75,7 @@ set( husd_sources
     HUSD_SetRelationships.C
     HUSD_ShaderTranslator.C
     HUSD_Skeleton.C
+    HUSD_SpatialIndex.C
     HUSD_SpecHandle.C
     HUSD_Stitch.C
     HUSD_TimeCode.C
@@ -182,6 +183,7 @@ set( husd_hdk_headers
     HUSD_SetRelationships.h
     HUSD_ShaderTranslator.h
     HUSD_Skeleton.h
+    HUSD_SpatialIndex.h
     HUSD_SpecHandle.h
     HUSD_Stitch.h
     HUSD_TimeCode.h
@@ -76,6 +76,17 @@ public:
                                         int fieldindex,
                                         const UT_StringRef &fieldtype);
 
+    // Volume files loaded by getVolumePrimitive are kept in a process-wide
+    // cache, capped by memory, so that each file is only read once no matter
+    // how many fields or consumers (the viewport, Karma, SOP unpacking)
+    // refer to it. Files are reloaded if their modification time changes.
+    static void                  clearVolumeCache();
+    static void                  setVolumeCacheSize(int64 size_in_mb);
+    // When enabled, fields from .vdb files are loaded one grid at a time,
+    // so only the grids that are actually requested are read from disk.
+    static void                  setLoadVDBGridsOnDemand(bool on_demand);
+    static bool                  loadVDBGridsOnDemand();
+
 private:
     UT_StringHolder                      myFilePath;
     UT_StringHolder                      myFieldName;
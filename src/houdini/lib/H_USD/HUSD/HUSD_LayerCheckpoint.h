@@ -20,18 +20,40 @@
 
 #include "HUSD_API.h"
 #include "HUSD_DataHandle.h"
+#include <UT/UT_UniquePtr.h>
 
 class HUSD_API HUSD_LayerCheckpoint
 {
 public:
-			 HUSD_LayerCheckpoint();
+    enum CheckpointMode {
+        // Copy the whole active layer on every create and restore.
+        FULL_COPY,
+        // Copy the whole active layer on the first create, then listen
+        // for change notices on the active layer. Subsequent calls to
+        // create and restore only copy the specs that were modified, so
+        // their cost scales with the size of the edits rather than the
+        // size of the layer. Because this relies on change notices, edits
+        // must be made through a layer lock that has been released before
+        // calling create or restore.
+        DELTA
+    };
+
+			 HUSD_LayerCheckpoint(
+                                CheckpointMode mode = FULL_COPY);
                         ~HUSD_LayerCheckpoint();
 
     void                 create(const HUSD_AutoAnyLock &lock);
     bool                 restore(const HUSD_AutoLayerLock &layerlock);
 
+    CheckpointMode       mode() const
+                         { return myMode; }
+
 private:
-    PXR_NS::XUSD_LayerPtr myLayer;
+    class husd_CheckpointJournal;
+
+    PXR_NS::XUSD_LayerPtr                myLayer;
+    UT_UniquePtr<husd_CheckpointJournal> myJournal;
+    CheckpointMode                       myMode;
 };
 
 #endif
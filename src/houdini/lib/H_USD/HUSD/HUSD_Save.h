@@ -82,6 +82,17 @@ public:
     bool                 myRequireDefaultPrim;
 };
 
+class husd_SaveStreamingData
+{
+public:
+                         husd_SaveStreamingData()
+                             : myChunkSize(0)
+                         { }
+
+    UT_StringHolder      myFilePath;
+    exint                myChunkSize;
+};
+
 class husd_SaveConfigFlags
 {
 public:
@@ -215,9 +226,30 @@ public:
     void                 setOutputProcessorsTime(fpreal t)
                          { myProcessorData.myConfigTime = t; }
 
-
+    // When saving a flattened stage, a non-zero chunk size makes
+    // addCombinedTimeSample write out every chunk_size time samples to a
+    // value clip file beside filepath, then release the combined stage, so
+    // long frame ranges don't have to fit in memory all at once. The final
+    // saveCombined call then writes a topology layer and clip metadata to
+    // filepath instead of a single file holding every time sample.
+    exint                streamingChunkSize() const
+                         { return myStreamingData.myChunkSize; }
+    const UT_StringHolder &streamingFilePath() const
+                         { return myStreamingData.myFilePath; }
+    void                 setStreaming(exint chunk_size,
+                                const UT_StringHolder &filepath)
+                         {
+                            myStreamingData.myChunkSize = chunk_size;
+                            myStreamingData.myFilePath = filepath;
+                         }
 
 private:
+    bool                 isStreaming() const;
+    bool                 addTimeSample(const HUSD_AutoReadLock &lock);
+    bool                 saveStreamingChunk();
+    bool                 saveStreamingClips(const UT_StringRef &filepath,
+                                UT_StringArray &saved_paths);
+
     class		 husd_SavePrivate;
 
     UT_UniquePtr<husd_SavePrivate>	 myPrivate;
@@ -227,6 +259,7 @@ private:
     husd_SaveDefaultPrimData		 myDefaultPrimData;
     husd_SaveTimeData                    myTimeData;
     husd_SaveConfigFlags                 myFlags;
+    husd_SaveStreamingData               myStreamingData;
 };
 
 #endif
@@ -40,6 +40,7 @@
 #include <UT/UT_StringSet.h>
 #include <UT/UT_IntrusivePtr.h>
 #include <UT/UT_Vector2.h>
+#include <SYS/SYS_AtomicInt.h>
 #include <SYS/SYS_Types.h>
 #include <GT/GT_Primitive.h>
 #include "HUSD_PrimHandle.h"
@@ -62,6 +63,7 @@ class HUSD_DataHandle;
 class husd_SceneTree;
 class husd_SceneNode;
 class husd_ConsolidatedPrims;
+class husd_PendingDisplayGeometry;
 
 
 typedef UT_IntrusivePtr<HUSD_HydraGeoPrim>  HUSD_HydraGeoPrimPtr;
@@ -76,7 +78,9 @@ public:
 	     HUSD_Scene();
     virtual ~HUSD_Scene();
 
-    UT_StringMap<HUSD_HydraGeoPrimPtr>  &geometry() { return myDisplayGeometry; }
+    UT_StringMap<HUSD_HydraGeoPrimPtr>  &geometry()
+                                        { flushDisplayGeometry();
+                                          return myDisplayGeometry; }
     UT_StringMap<HUSD_HydraCameraPtr>   &cameras()  { return myCameras; }
     UT_StringMap<HUSD_HydraLightPtr>    &lights()   { return myLights; }
     UT_StringMap<HUSD_HydraMaterialPtr> &materials(){ return myMaterials; }
@@ -113,8 +117,11 @@ public:
     void addGeometry(HUSD_HydraGeoPrim *geo, bool new_geo);
     void removeGeometry(HUSD_HydraGeoPrim *geo);
 
+    // These may be called concurrently from Sync(). The display list is
+    // updated the next time it is accessed, or in postUpdate().
     void addDisplayGeometry(HUSD_HydraGeoPrim *geo);
     void removeDisplayGeometry(HUSD_HydraGeoPrim *geo);
+    void flushDisplayGeometry();
 
     virtual void addCamera(HUSD_HydraCamera *cam, bool new_cam);
     virtual void removeCamera(HUSD_HydraCamera *cam);
@@ -178,7 +185,7 @@ public:
     HUSD_HydraGeoPrimPtr findConsolidatedPrim(int id) const;
     
     // Volumes
-    const UT_StringSet &volumesUsingField(const UT_StringRef &field) const;
+    UT_StringSet volumesUsingField(const UT_StringRef &field) const;
     void addVolumeUsingField(const UT_StringHolder &volume,
 			     const UT_StringHolder &field);
     void removeVolumeUsingFields(const UT_StringRef &volume);
@@ -232,13 +239,13 @@ public:
     static int  getMaxGeoIndex();
     
     // bumped when a geo prim is added or removed.
-    int64	getGeoSerial() const    { return myGeoSerial; }
+    int64	getGeoSerial() const    { return myGeoSerial.relaxedLoad(); }
     int64	getCameraSerial() const { return myCamSerial; }
     int64	getLightSerial() const  { return myLightSerial; }
     
     // bumped when any prim has Sync() called.
-    int64       getModSerial() const { return myModSerial; }
-    void        bumpModSerial() { myModSerial++; }
+    int64       getModSerial() const { return myModSerial.relaxedLoad(); }
+    void        bumpModSerial() { myModSerial.add(1); }
 
     enum PrimType
     {
@@ -294,7 +301,9 @@ public:
 
     void         debugPrintTree();
 protected:
-    virtual void geometryDisplayed(HUSD_HydraGeoPrim *, bool) {}
+    // The index is the display index the change was queued with, which may
+    // differ from the prim's current index if it has been redisplayed.
+    virtual void geometryDisplayed(HUSD_HydraGeoPrim *, bool, int) {}
     bool	 selectionModified(int id);
     bool         selectionModified(husd_SceneNode *pnode);
     UT_StringHolder instanceIDLookup(const UT_StringRef &pick_path,
@@ -342,8 +351,8 @@ protected:
     bool                                mySelectionArrayNeedsUpdate;
     int64				myHighlightID;
     int64				mySelectionID;
-    int64				myGeoSerial;
-    int64                               myModSerial;
+    SYS_AtomicInt64			myGeoSerial;
+    SYS_AtomicInt64                     myModSerial;
     int64                               myCamSerial;
     int64                               myLightSerial;
     int64                               mySelectionResolveSerial;
@@ -355,6 +364,7 @@ protected:
     UT_Lock				myLightCamLock;
     UT_Lock				myMaterialLock;
     UT_Lock                             myCategoryLock;
+    mutable UT_Lock                     myFieldsLock;
 
     UT_StringMap<int>                   myLightLinkCategories;
     UT_StringMap<int>                   myShadowLinkCategories;
@@ -372,6 +382,7 @@ protected:
 
     husd_SceneTree                     *myTree;
     husd_ConsolidatedPrims             *myPrimConsolidator;
+    husd_PendingDisplayGeometry        *myPendingDisplayGeometry;
 
     UT_StringMap<PXR_NS::XUSD_HydraInstancer *> myInstancers;
 };
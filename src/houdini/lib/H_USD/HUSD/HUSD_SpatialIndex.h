@@ -0,0 +1,89 @@
+/*
+ * Copyright 2019 Side Effects Software Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Produced by:
+ *	Side Effects Software Inc.
+ *	123 Front Street West, Suite 1401
+ *	Toronto, Ontario
+ *      Canada   M5J 2M2
+ *	416-504-9876
+ *
+ */
+
+#ifndef __HUSD_SpatialIndex_h__
+#define __HUSD_SpatialIndex_h__
+
+#include "HUSD_API.h"
+#include "HUSD_DataHandle.h"
+#include "HUSD_TimeCode.h"
+#include "HUSD_Utils.h"
+#include <UT/UT_Array.h>
+#include <UT/UT_BoundingBox.h>
+#include <UT/UT_StringArray.h>
+#include <UT/UT_UniquePtr.h>
+#include <UT/UT_VectorTypes.h>
+#include <SYS/SYS_Types.h>
+
+// A bounding volume hierarchy over the world space bounds of the boundable
+// prims (gprims, point instancers, volumes) on a stage at one time code.
+// The first update() computes the bounds of every prim. After that the
+// index listens for change notices on the stage, and later updates only
+// recompute the bounds of prims that were edited, resynced, or whose
+// ancestors were edited. Changing the stage, purposes, or traversal
+// demands rebuilds the index from scratch. Changing the time code
+// recomputes all the bounds but does not traverse the stage again.
+//
+// Queries append matching prim paths to the supplied array and are only
+// valid after a successful call to update().
+class HUSD_API HUSD_SpatialIndex
+{
+public:
+			 HUSD_SpatialIndex();
+			~HUSD_SpatialIndex();
+
+    bool		 update(HUSD_AutoAnyLock &lock,
+				const HUSD_TimeCode &timecode,
+				const UT_StringArray &purposes,
+				HUSD_PrimTraversalDemands demands =
+				    HUSD_TRAVERSAL_DEFAULT_DEMANDS);
+    void		 clear();
+
+    exint		 entries() const;
+
+    // Finds prims with bounds that overlap the box, or that are entirely
+    // inside the box if fully_inside is true.
+    void		 findInBox(const UT_BoundingBoxD &box,
+				bool fully_inside,
+				UT_StringArray &paths) const;
+    // Finds prims with bounds that are at least partially inside the convex
+    // volume bounded by the planes. Each plane is stored as (N, d), where
+    // the inside of the plane is the half space dot(N, P) + d >= 0.
+    void		 findInFrustum(const UT_Array<UT_Vector4D> &planes,
+				UT_StringArray &paths) const;
+    // Finds prims with bounds hit by the ray, sorted by the distance along
+    // the ray to where it enters the bounds.
+    void		 findOnRay(const UT_Vector3D &orig,
+				const UT_Vector3D &dir,
+				UT_StringArray &paths,
+				fpreal64 tmax = SYS_FP64_MAX) const;
+
+private:
+    class husd_SpatialIndexPrivate;
+
+    UT_UniquePtr<husd_SpatialIndexPrivate>	 myPrivate;
+};
+
+#endif
+
@@ -42,6 +42,11 @@ class HUSD_API XUSD_FindPrimsTaskData
 public:
     virtual ~XUSD_FindPrimsTaskData();
     virtual void addToThreadData(UsdPrim &prim) = 0;
+
+    // Called for each prim matching the traversal pattern. Subclasses can
+    // set prune_children to skip the descendants of the prim. The default
+    // implementation calls addToThreadData.
+    virtual void addMatchedPrim(UsdPrim &prim, bool &prune_children);
 };
 
 // Subclass of XUSD_FindPrimsTaskData that specifically collects the SdfPaths
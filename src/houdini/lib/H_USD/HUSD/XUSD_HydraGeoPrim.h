@@ -96,6 +96,17 @@ public:
     void	clearGTSelection();
 
     const UT_StringArray &materials() const { return myMaterials; }
+
+    /// Timing counters for primvar syncs, accumulated over all prims.
+    struct PrimvarSyncStats
+    {
+	int64		 mySyncs;	// Number of batched primvar fetches
+	int64		 myPrimvars;	// Number of primvars fetched
+	fpreal64	 myFetchTime;	// Seconds spent fetching values
+	fpreal64	 myUpdateTime;	// Seconds spent updating attributes
+    };
+    static PrimvarSyncStats	primvarSyncStats();
+    static void			resetPrimvarSyncStats();
     
 protected:
     void	resetPrim();
@@ -131,6 +142,17 @@ protected:
 			     bool		       set_point_freq = false,
 			     bool		      *exists = nullptr,
                              GT_DataArrayHandle        vert_index = nullptr);
+
+    // Fetch the values of all of the dirty primvars in usd_attribs in one
+    // pass, so that subsequent updateAttrib() calls can use them instead
+    // of each pulling its primvar from the scene delegate. Computed
+    // primvars are evaluated together. The values are held until
+    // clearFetchedPrimvars() is called.
+    void	fetchPrimvars(HdSceneDelegate		*scene_delegate,
+			      const SdfPath		&id,
+			      HdDirtyBits		*dirty_bits,
+			      const UT_Array<TfToken>	&usd_attribs);
+    void	clearFetchedPrimvars();
     
     void	createInstance(HdSceneDelegate          *scene_delegate,
 			       const SdfPath		&proto_id,
@@ -168,6 +190,8 @@ protected:
     UT_StringMap<UT_Tuple<GT_Owner,int, bool, void *> >  myAttribMap;
     UT_StringMap<UT_StringHolder> myExtraAttribs;
     UT_StringMap<UT_StringHolder> myExtraUVAttribs;
+    UT_StringMap<VtValue>	 myFetchedPrimvars;
+    bool			 myHasFetchedPrimvars;
     GT_PrimitiveHandle		&myGTPrim;
     GT_PrimitiveHandle		&myInstance;
     int				&myDirtyMask;
@@ -235,6 +259,7 @@ protected:
     void	_InitRepr(TfToken const &representation,
 				  HdDirtyBits *dirty_bits) override;
     bool                generatePointNormals(GT_PrimitiveHandle &mesh);
+    bool                updateNormalAdjacency(exint npts);
     void                consolidateMesh(HdSceneDelegate    *scene_delegate,
                                         GT_PrimPolygonMesh *mesh,
                                         SdfPath const      &id,
@@ -244,6 +269,14 @@ protected:
 
     GT_DataArrayHandle		 myCounts, myVertex;
     int64			 myTopHash;
+
+    // Face offsets and point-to-face adjacency of myCounts/myVertex, used
+    // to compute point normals. Only rebuilt when the topology changes.
+    UT_Array<int>		 myFaceOffsets;
+    UT_Array<int>		 myPointFaceOffsets;
+    UT_Array<int>		 myPointFaces;
+    int64			 myNormalTopHash;
+    exint			 myNormalNumPoints;
     bool			 myIsSubD;
     bool			 myIsLeftHanded;
     int				 myRefineLevel;
@@ -63,9 +63,9 @@ public:
 				const HUSD_TimeCode &timecode);
 			~XUSD_PathPattern() override;
 
-    void		 getSpecialTokenPaths(SdfPathSet &collection_paths,
-				SdfPathSet &expanded_collection_paths,
-				SdfPathSet &vexpression_paths) const;
+    void		 getSpecialTokenPaths(XUSD_PathSet &collection_paths,
+				XUSD_PathSet &expanded_collection_paths,
+				XUSD_PathSet &vexpression_paths) const;
 };
 
 PXR_NAMESPACE_CLOSE_SCOPE
@@ -26,18 +26,86 @@
 #define __XUSD_PathSet_h__
 
 #include "HUSD_API.h"
+#include <UT/UT_SharedPtr.h>
 #include <pxr/usd/sdf/path.h>
+#include <utility>
 
 PXR_NAMESPACE_OPEN_SCOPE
 
-class HUSD_API XUSD_PathSet : public SdfPathSet
+// A set of SdfPaths stored as a sorted array, iterated in the same order as
+// an SdfPathSet. Copies share the array until one of them is modified.
+// Inserting paths one at a time is only cheap if they arrive in sorted
+// order, so gather unsorted paths into an SdfPathVector and insert them all
+// at once.
+class HUSD_API XUSD_PathSet
 {
 public:
+    typedef SdfPath				 key_type;
+    typedef SdfPath				 value_type;
+    typedef SdfPathVector::const_iterator	 const_iterator;
+    typedef const_iterator			 iterator;
+    typedef size_t				 size_type;
+
 			 XUSD_PathSet();
+			 XUSD_PathSet(const XUSD_PathSet &src);
+			 XUSD_PathSet(XUSD_PathSet &&src);
                          XUSD_PathSet(const SdfPathSet &src);
+    explicit		 XUSD_PathSet(SdfPathVector &&src);
 			~XUSD_PathSet();
 
+    XUSD_PathSet	&operator=(const XUSD_PathSet &src);
+    XUSD_PathSet	&operator=(XUSD_PathSet &&src);
     const XUSD_PathSet  &operator=(const SdfPathSet &src);
+
+    const_iterator	 begin() const
+			 { return myPaths ? myPaths->cbegin()
+					  : theEmptyPaths.cbegin(); }
+    const_iterator	 end() const
+			 { return myPaths ? myPaths->cend()
+					  : theEmptyPaths.cend(); }
+    bool		 empty() const
+			 { return !myPaths || myPaths->empty(); }
+    size_type		 size() const
+			 { return myPaths ? myPaths->size() : 0; }
+    void		 clear()
+			 { myPaths.reset(); }
+    void		 swap(XUSD_PathSet &other)
+			 { myPaths.swap(other.myPaths); }
+
+    const_iterator	 lower_bound(const SdfPath &path) const;
+    const_iterator	 find(const SdfPath &path) const;
+    size_type		 count(const SdfPath &path) const
+			 { return (find(path) != end()) ? 1 : 0; }
+
+    // The range of paths in the set that have "path" as a prefix, including
+    // "path" itself.
+    std::pair<const_iterator, const_iterator>
+			 subtree(const SdfPath &path) const;
+
+    std::pair<iterator, bool>	 insert(const SdfPath &path);
+    iterator		 insert(const_iterator hint, const SdfPath &path);
+    std::pair<iterator, bool>	 emplace(const SdfPath &path)
+			 { return insert(path); }
+    template <typename ITER>
+    void		 insert(ITER first, ITER last)
+			 { insert(SdfPathVector(first, last)); }
+    void		 insert(SdfPathVector &&paths);
+    void		 insert(const XUSD_PathSet &paths);
+
+    iterator		 erase(const_iterator it);
+    iterator		 erase(const_iterator first, const_iterator last);
+    size_type		 erase(const SdfPath &path);
+
+    // These run in linear time in the size of both sets.
+    void		 intersect(const XUSD_PathSet &paths);
+    void		 subtract(const XUSD_PathSet &paths);
+
+private:
+    SdfPathVector	&edit();
+
+    UT_SharedPtr<SdfPathVector>	 myPaths;
+
+    static const SdfPathVector	 theEmptyPaths;
 };
 
 PXR_NAMESPACE_CLOSE_SCOPE
@@ -46,6 +46,8 @@
 #include <GT/GT_RefineParms.h>
 #include <GU/GU_PrimPacked.h>
 #include <UT/UT_Options.h>
+#include <UT/UT_ParallelUtil.h>
+#include <UT/UT_Set.h>
 
 #include "pxr/usd/usdGeom/xformCache.h"
 
@@ -297,6 +299,55 @@ public:
         const UT_Array<const GU_PrimPacked *>   &myPrims;
     };
 
+    // Evaluates the bounds and transform of each prim once, so that the
+    // lazily computed USD prim, transform and bounds of its implementation
+    // are cached. The prims must all have distinct implementations.
+    class PrimeTask
+    {
+    public:
+        PrimeTask(const UT_Array<const GU_PrimPacked *>&prims)
+            : myPrims(prims)
+        {
+        }
+        void    operator()(const UT_BlockedRange<exint> &range) const
+        {
+            UT_BoundingBox  box;
+            UT_Matrix4D     m4d;
+            for (exint i = range.begin(); i != range.end(); ++i)
+            {
+                myPrims(i)->getUntransformedBounds(box);
+                myPrims(i)->getFullTransform4(m4d);
+            }
+        }
+    private:
+        const UT_Array<const GU_PrimPacked *>   &myPrims;
+    };
+
+    static void
+    fillProxies(UT_BoundingBox *boxes,
+        UT_Matrix4F *xforms,
+        const UT_Array<const GU_PrimPacked *>&prims)
+    {
+        // Packed prims may share an implementation, whose caches are not
+        // safe to fill from multiple threads. Fill the caches of each
+        // unique implementation first, so the FillTask only reads them.
+        UT_Set<const GU_PackedImpl *>           seen;
+        UT_Array<const GU_PrimPacked *>         unique;
+        for (const GU_PrimPacked *prim : prims)
+        {
+            if (seen.insert(prim->sharedImplementation()).second)
+                unique.append(prim);
+        }
+        if (unique.entries() != prims.entries())
+        {
+            UTparallelFor(UT_BlockedRange<exint>(0, unique.entries()),
+                PrimeTask(unique));
+        }
+
+        UTparallelFor(UT_BlockedRange<exint>(0, prims.entries()),
+            FillTask(boxes, xforms, prims));
+    }
+
     void
     addInstances( 
         GT_PrimCollect& collection, 
@@ -374,9 +425,7 @@ public:
 
         if (nbox)
         {
-            //UTparallelFor(UT_BlockedRange<exint>(0, nbox),
-            UTserialFor(UT_BlockedRange<exint>(0, nbox),
-                FillTask(boxes, xforms, _boxPrims));
+            fillProxies(boxes, xforms, _boxPrims);
             for (exint i = 0; i < nbox; ++i)
             {
                 boxdata.appendBox(boxes[i], xforms[i],
@@ -389,9 +438,7 @@ public:
         }
         if (ncentroid)
         {
-            //UTparallelFor(UT_BlockedRange<exint>(0, ncentroid),
-            UTserialFor(UT_BlockedRange<exint>(0, ncentroid),
-                FillTask(boxes, xforms, _centroidPrims));
+            fillProxies(boxes, xforms, _centroidPrims);
             for (exint i = 0; i < ncentroid; ++i)
             {
                 boxdata.appendCentroid(boxes[i], xforms[i],
@@ -31,10 +31,18 @@
 #include "USD_XformCache.h"
 #include "UT_Gf.h"
 
+#include "pxr/base/arch/fileSystem.h"
+#include "pxr/base/tf/envSetting.h"
+#include "pxr/base/tf/fileUtils.h"
+#include "pxr/base/tf/pathUtils.h"
+#include "pxr/base/tf/stringUtils.h"
+#include "pxr/usd/usd/stage.h"
 #include "pxr/usd/usdGeom/boundable.h"
+#include "pxr/usd/usdGeom/primvarsAPI.h"
 #include "pxr/usd/usdGeom/xformable.h"
 
 #include <GT/GT_CatPolygonMesh.h>
+#include <GT/GT_GEODetail.h>
 #include <GT/GT_PrimCollect.h>
 #include <GT/GT_PrimInstance.h>
 #include <GT/GT_PrimPolygonMesh.h>
@@ -42,11 +50,23 @@
 #include <GT/GT_RefineParms.h>
 #include <GT/GT_TransformArray.h>
 #include <GT/GT_PackedAlembic.h>
+#include <GT/GT_Util.h>
+#include <GU/GU_Detail.h>
 #include <SYS/SYS_Hash.h>
+#include <SYS/SYS_SequentialThreadIndex.h>
 #include <UT/UT_HDKVersion.h>
+#include <UT/UT_WorkBuffer.h>
 
+#include <algorithm>
+#include <cstdio>
 #include <iostream>
 
+#ifndef _WIN32
+#include <unistd.h>
+#else
+#include <process.h>
+#endif
+
 PXR_NAMESPACE_OPEN_SCOPE
 
 #ifdef DEBUG
@@ -62,6 +82,17 @@ using std::endl;
 typedef UT_IntrusivePtr<GT_PrimPolygonMesh> GT_PrimPolygonMeshHandle;
 
 
+TF_DEFINE_ENV_SETTING(GUSD_GT_PRIMCACHE_DIR, "",
+                      "Directory used to store viewport geometry converted "
+                      "from USD gprims, so that it can be reused by later "
+                      "sessions. The disk cache is disabled if empty.");
+
+TF_DEFINE_ENV_SETTING(GUSD_GT_PRIMCACHE_DIR_MAXSIZE, 4096,
+                      "Maximum size of the GT prim disk cache directory, in "
+                      "megabytes. The oldest files are removed once the "
+                      "directory grows past this size. Zero means no limit.");
+
+
 ////////////////////////////////////////////////////////////////////////////////////////////
 
 namespace {
@@ -203,6 +234,83 @@ namespace {
 
     typedef GusdUT_CappedKey<CacheKeyValue, CacheKeyValue::HashCmp> CacheKey;
 
+    // Bump this whenever the contents of the disk cache files change, so
+    // that files written by older builds are ignored.
+    constexpr int64 theDiskFormatVersion = 1;
+
+    // Compute a hash of the identifiers and modification times of all the
+    // layers used by a stage, and of its population mask. Returns false if
+    // the stage has layers whose contents can't be identified from disk
+    // (anonymous or modified layers).
+    bool
+    computeStageSignature( const UsdStagePtr &stage,
+                           SdfLayerHandleVector &layers,
+                           SYS_HashType &signature )
+    {
+        UT_Array<SYS_HashType> layerHashes;
+
+        layers = stage->GetUsedLayers();
+        for( const SdfLayerHandle &layer : layers ) {
+            if( !layer || layer->IsAnonymous() || layer->IsDirty() ) {
+                return false;
+            }
+
+            SYS_HashType h = SYSstring_hash( layer->GetIdentifier().c_str() );
+
+            const std::string &realPath = layer->GetRealPath();
+            if( !realPath.empty() ) {
+                double modTime = 0;
+                if( !ArchGetModificationTime( realPath.c_str(), &modTime )) {
+                    return false;
+                }
+                SYShashCombine( h, modTime );
+            }
+            layerHashes.append( h );
+        }
+
+        // The order of the used layers is not guaranteed to be stable.
+        layerHashes.stdsort( std::less<SYS_HashType>() );
+
+        signature = SYSwang_inthash64( theDiskFormatVersion );
+        for( SYS_HashType h : layerHashes ) {
+            SYShashCombine( signature, h );
+        }
+        for( const SdfPath &path : stage->GetPopulationMask().GetPaths() ) {
+            SYShashCombine( signature, SYSstring_hash( path.GetText() ));
+        }
+        return true;
+    }
+
+    // Returns true if the geometry converted from a gprim may differ
+    // between frames. Only prims that don't vary are stored on disk, so
+    // that all frames can share a single file.
+    bool
+    isMaybeTimeVarying( const UsdPrim &prim )
+    {
+        auto info = GusdUSD_XformCache::GetInstance().GetXformInfo( prim );
+        if( !info || info->WorldXformIsMaybeTimeVarying() ) {
+            return true;
+        }
+
+        for( const UsdAttribute &attr : prim.GetAttributes() ) {
+            if( attr.ValueMightBeTimeVarying() ) {
+                return true;
+            }
+        }
+
+        // Constant primvars may be inherited from ancestors.
+        for( UsdPrim parent = prim.GetParent();
+             parent && !parent.IsPseudoRoot(); parent = parent.GetParent() ) {
+            for( const UsdGeomPrimvar &primvar :
+                     UsdGeomPrimvarsAPI( parent ).GetPrimvars() ) {
+                if( primvar.ValueMightBeTimeVarying() ) {
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+
 }; // end namespace 
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -218,12 +326,22 @@ GusdGT_PrimCache::GetInstance()
 ////////////////////////////////////////////////////////////////////////////////
 
 GusdGT_PrimCache::GusdGT_PrimCache() : 
-    _prims( "GusdGT_PrimCache", 1024 )
+    _prims( "GusdGT_PrimCache", 1024 ),
+    _diskMaxSize( int64(TfGetEnvSetting( GUSD_GT_PRIMCACHE_DIR_MAXSIZE ))
+                  * 1024 * 1024 ),
+    _diskSize( 0 ),
+    _diskDirInUse( 0 ),
+    _diskWriting( false )
 {
+    const std::string &dir = TfGetEnvSetting( GUSD_GT_PRIMCACHE_DIR );
+    if( !dir.empty() ) {
+        SetDiskCacheDir( dir );
+    }
 }
 
 GusdGT_PrimCache::~GusdGT_PrimCache()
 {
+    _diskWriteTask.wait();
 }
 
 GT_PrimitiveHandle 
@@ -252,11 +370,21 @@ void
 GusdGT_PrimCache::Clear()
 {
     _prims.clear();
+
+    UT_AutoLock lock( _signatureLock );
+    _signatures.clear();
 }
 
 int64
 GusdGT_PrimCache::Clear(const UT_StringSet& paths)
 {
+    // Layers may have been reloaded, so their signatures need to be
+    // recomputed.
+    {
+        UT_AutoLock lock( _signatureLock );
+        _signatures.clear();
+    }
+
     return _prims.ClearEntries(
         [&](const UT_CappedKeyHandle& key,
             const UT_CappedItemHandle& item) {
@@ -266,6 +394,276 @@ GusdGT_PrimCache::Clear(const UT_StringSet& paths)
     });
 }
 
+void
+GusdGT_PrimCache::SetDiskCacheDir( const UT_StringHolder &dir )
+{
+    {
+        UT_AutoLock lock( _diskLock );
+
+        // Readers use the directory without locking, so it can't change
+        // once they've started using it.
+        if( _diskDirInUse.load() ) {
+            TF_WARN( "The GT prim cache directory can't be changed once "
+                     "it is in use." );
+            return;
+        }
+
+        if( dir.isstring() && !TfIsDir( dir.toStdString() ) &&
+            !TfMakeDirs( dir.toStdString(), -1, /* existOk */ true )) {
+            TF_WARN( "Unable to create GT prim cache directory '%s'.",
+                     dir.c_str() );
+            _diskDir.clear();
+            return;
+        }
+        _diskDir = dir;
+        _diskSize.store( 0 );
+    }
+    _TrimDiskCache();
+}
+
+void
+GusdGT_PrimCache::SetDiskCacheMaxSize( int64 bytes )
+{
+    _diskMaxSize.store( bytes );
+    _TrimDiskCache();
+}
+
+void
+GusdGT_PrimCache::_TrimDiskCache()
+{
+    UT_AutoLock lock( _diskLock );
+
+    if( !_diskDir.isstring() ) {
+        return;
+    }
+
+    struct DiskFile
+    {
+        double      modTime;
+        int64       size;
+        std::string path;
+    };
+
+    std::vector<std::string> dirnames, filenames, symlinknames;
+    if( !TfReadDir( _diskDir.toStdString(), &dirnames, &filenames,
+                    &symlinknames )) {
+        return;
+    }
+
+    // Rescan the directory rather than trusting the running total, since
+    // other sessions may share the same directory.
+    UT_Array<DiskFile> files;
+    int64 total = 0;
+    for( const std::string &name : filenames ) {
+        if( !TfStringEndsWith( name, ".bgeo" )) {
+            continue;
+        }
+
+        DiskFile file;
+        file.path = TfStringCatPaths( _diskDir.toStdString(), name );
+        file.size = ArchGetFileLength( file.path.c_str() );
+        if( file.size < 0 ||
+            !ArchGetModificationTime( file.path.c_str(), &file.modTime )) {
+            continue;
+        }
+        total += file.size;
+        files.append( file );
+    }
+
+    // Remove the oldest files until we're comfortably under the limit, so
+    // that we don't rescan the directory on every save.
+    const int64 maxSize = _diskMaxSize.load();
+    if( maxSize > 0 && total > maxSize ) {
+        const int64 target = maxSize - maxSize / 10;
+
+        files.stdsort( []( const DiskFile &a, const DiskFile &b )
+                       { return a.modTime < b.modTime; } );
+        for( const DiskFile &file : files ) {
+            if( total <= target ) {
+                break;
+            }
+            if( std::remove( file.path.c_str() ) == 0 ) {
+                total -= file.size;
+            }
+        }
+    }
+    _diskSize.store( total );
+}
+
+bool
+GusdGT_PrimCache::_GetStageSignature( const UsdStagePtr &stage,
+                                      SYS_HashType &signature )
+{
+    UT_AutoLock lock( _signatureLock );
+
+    // Only stat the layers once per stage. Reloads clear the signatures,
+    // and edits are caught by checking the layers' dirty state.
+    auto it = _signatures.find( get_pointer( stage ));
+    if( it != _signatures.end() && it->second.stage == stage ) {
+        const _StageSignature &sig = it->second;
+        if( !sig.valid ) {
+            return false;
+        }
+        for( const SdfLayerHandle &layer : sig.layers ) {
+            if( !layer || layer->IsDirty() ) {
+                return false;
+            }
+        }
+        signature = sig.hash;
+        return true;
+    }
+
+    _StageSignature &sig = _signatures[ get_pointer( stage ) ];
+    sig.stage = stage;
+    sig.hash = 0;
+    sig.valid = computeStageSignature( stage, sig.layers, sig.hash );
+    signature = sig.hash;
+    return sig.valid;
+}
+
+bool
+GusdGT_PrimCache::GetDiskPath( const UsdPrim &usdPrim,
+                               GusdPurposeSet purposes,
+                               UT_StringHolder &path )
+{
+    // The directory is frozen the first time the cache is used, after
+    // which it can be read without locking.
+    if( !_diskDirInUse.load() ) {
+        UT_AutoLock lock( _diskLock );
+        _diskDirInUse.store( 1 );
+    }
+    if( !_diskDir.isstring() ) {
+        return false;
+    }
+
+    // Prims in instance masters are only identified by their master's path,
+    // and master numbering isn't stable between stage loads, so the path
+    // could refer to a different prototype next time.
+    if( usdPrim.IsInMaster() || isMaybeTimeVarying( usdPrim )) {
+        return false;
+    }
+
+    SYS_HashType h = 0;
+    if( !_GetStageSignature( usdPrim.GetStage(), h )) {
+        return false;
+    }
+
+    SYShashCombine( h, SYSstring_hash( usdPrim.GetPath().GetText() ));
+    SYShashCombine( h, int(purposes) );
+
+    // The prim is composed differently depending on whether its payload
+    // is part of the stage's load set.
+    SYShashCombine( h, usdPrim.IsLoaded() );
+
+    UT_WorkBuffer buf;
+    buf.sprintf( "%s/%016llx.bgeo", _diskDir.c_str(),
+                 (unsigned long long)h );
+    path = buf;
+    return true;
+}
+
+GT_PrimitiveHandle
+GusdGT_PrimCache::LoadFromDisk( const UT_StringHolder &path )
+{
+    if( !TfIsFile( path.toStdString() )) {
+        return GT_PrimitiveHandle();
+    }
+
+    GU_Detail *gdp = new GU_Detail;
+    GU_DetailHandle gdh;
+    gdh.allocateAndSet( gdp );
+
+    if( !gdp->load( path.c_str() ).success() ) {
+        DBG( cerr << "Failed to load cached prim " << path << endl; )
+        return GT_PrimitiveHandle();
+    }
+
+    return GT_GEODetail::makeDetail( gdh );
+}
+
+void
+GusdGT_PrimCache::SaveToDisk( const UT_StringHolder &path,
+                              const GT_PrimitiveHandle &gtPrim,
+                              const GT_RefineParms &refineParms )
+{
+    if( !gtPrim ) {
+        return;
+    }
+
+    // Queue the write, and start a background task to drain the queue if
+    // one isn't already running, so that cooks never wait on disk I/O.
+    {
+        UT_AutoLock lock( _diskWriteLock );
+        _diskWrites.append( _DiskWrite{ path, gtPrim, refineParms } );
+        if( _diskWriting ) {
+            return;
+        }
+        _diskWriting = true;
+    }
+    _diskWriteTask.run( [this]() { _FlushDiskWrites(); } );
+}
+
+void
+GusdGT_PrimCache::_FlushDiskWrites()
+{
+    while( true ) {
+        UT_Array<_DiskWrite> writes;
+        {
+            UT_AutoLock lock( _diskWriteLock );
+            if( _diskWrites.isEmpty() ) {
+                _diskWriting = false;
+                return;
+            }
+            writes.swap( _diskWrites );
+        }
+
+        for( const _DiskWrite &write : writes ) {
+            _WriteToDisk( write );
+        }
+    }
+}
+
+void
+GusdGT_PrimCache::_WriteToDisk( const _DiskWrite &write )
+{
+    UT_Array<GU_Detail *> details;
+    GT_Util::makeGEO( details, write.prim, &write.refineParms );
+
+    GU_Detail gdp;
+    for( GU_Detail *detail : details ) {
+        gdp.merge( *detail );
+        delete detail;
+    }
+
+    // Write to a temporary file and rename it into place, so other threads
+    // and processes never load a partially written file.
+    const UT_StringHolder &path = write.path;
+    UT_WorkBuffer tmpPath;
+#ifndef _WIN32
+    tmpPath.sprintf( "%s.%d.%d.tmp", path.c_str(), int(getpid()),
+                     int(SYSgetSTID()) );
+#else
+    tmpPath.sprintf( "%s.%d.%d.tmp", path.c_str(), int(_getpid()),
+                     int(SYSgetSTID()) );
+#endif
+
+    if( !gdp.save( tmpPath.buffer(), nullptr ).success() ) {
+        DBG( cerr << "Failed to save cached prim " << path << endl; )
+        std::remove( tmpPath.buffer() );
+        return;
+    }
+    if( std::rename( tmpPath.buffer(), path.c_str() ) != 0 ) {
+        std::remove( tmpPath.buffer() );
+        return;
+    }
+
+    const int64 size = ArchGetFileLength( path.c_str() );
+    const int64 maxSize = _diskMaxSize.load();
+    if( size > 0 && _diskSize.add( size ) > maxSize && maxSize > 0 ) {
+        _TrimDiskCache();
+    }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 
 UT_IntrusivePtr<UT_CappedItem> 
@@ -325,11 +723,24 @@ CreateEntryFn::operator()(
 
         DBG( cerr << "Create prim cache for gprim " << prim.GetPath() << " at " << time << endl; )
 
-        GT_PrimitiveHandle gp = 
-            GusdPrimWrapper::defineForRead( 
+        // Geometry from the disk cache has already been converted from USD,
+        // so it only needs to be refined.
+        UT_StringHolder diskPath;
+        const bool useDisk = m_cache.GetDiskPath( prim, purposes, diskPath );
+
+        GT_PrimitiveHandle gp;
+        if( useDisk ) {
+            gp = m_cache.LoadFromDisk( diskPath );
+        }
+        if( !gp ) {
+            gp = GusdPrimWrapper::defineForRead( 
                                 imageable,
                                 time,
                                 purposes );
+            if( useDisk ) {
+                m_cache.SaveToDisk( diskPath, gp, refineParms );
+            }
+        }
         if( gp ) {              
             gp->refine( refiner, &refineParms );
         }
@@ -31,8 +31,17 @@
 #include "UT_CappedCache.h"
 
 #include <GT/GT_Primitive.h>
+#include <GT/GT_RefineParms.h>
+#include <UT/UT_Array.h>
+#include <UT/UT_Lock.h>
+#include <UT/UT_Map.h>
+#include <UT/UT_StringHolder.h>
+#include <UT/UT_TaskGroup.h>
+#include <SYS/SYS_AtomicInt.h>
+#include <SYS/SYS_Hash.h>
 
 #include "pxr/pxr.h"
+#include "pxr/usd/sdf/layer.h"
 #include "pxr/usd/usd/prim.h"
 
 PXR_NAMESPACE_OPEN_SCOPE
@@ -43,6 +52,18 @@ PXR_NAMESPACE_OPEN_SCOPE
 // The GT prims are refined to prims that can be directly imaged in the Houdini 
 // view port.
 // The cache is build atop a UT_CappedCache (a LRU cache).
+//
+// Optionally, converted gprims are also stored in a directory on disk (set
+// with SetDiskCacheDir, or the GUSD_GT_PRIMCACHE_DIR environment variable), so
+// later sessions can skip the USD to GT conversion. Disk entries are keyed
+// by the identifiers and modification times of the stage's layers, the
+// stage's population mask, the prim path, purposes and whether the prim is
+// loaded. Only prims that can't vary over time are stored, so one file
+// serves every frame. Stages with anonymous or modified layers, and prims
+// inside instance masters, are never stored on disk. Files are written by a
+// background task rather than during the cook. The directory is capped in
+// size (GUSD_GT_PRIMCACHE_DIR_MAXSIZE, or SetDiskCacheMaxSize), and the
+// oldest files are removed once it grows past the cap.
 
 class GusdGT_PrimCache : public GusdUSD_DataCache {
 
@@ -62,9 +83,71 @@ public:
     virtual void    Clear() override;
     virtual int64   Clear(const UT_StringSet& paths) override;
 
+    /// Set the directory used for the disk tier of the cache. An empty
+    /// string disables the disk tier. The directory can't be changed once
+    /// the cache has been used.
+    GUSD_API
+    void            SetDiskCacheDir(const UT_StringHolder& dir);
+    const UT_StringHolder& GetDiskCacheDir() const { return _diskDir; }
+
+    /// Set the maximum size of the disk tier, in bytes. Zero means no limit.
+    GUSD_API
+    void            SetDiskCacheMaxSize(int64 bytes);
+    int64           GetDiskCacheMaxSize() const { return _diskMaxSize.load(); }
+
+    /// Get the disk tier file for a gprim. Returns false if the disk tier
+    /// is disabled, the prim may vary over time, or the prim's stage can't
+    /// be keyed.
+    bool                GetDiskPath( const UsdPrim &usdPrim,
+                                     GusdPurposeSet purposes,
+                                     UT_StringHolder &path );
+
+    /// Load the geometry for a gprim from the disk tier.
+    GT_PrimitiveHandle  LoadFromDisk( const UT_StringHolder &path );
+
+    /// Queue the geometry for a gprim to be written to the disk tier.
+    /// The file is written by a background task.
+    void                SaveToDisk( const UT_StringHolder &path,
+                                    const GT_PrimitiveHandle &gtPrim,
+                                    const GT_RefineParms &refineParms );
+
 private:
 
+    struct _StageSignature
+    {
+        UsdStagePtr          stage;
+        SdfLayerHandleVector layers;
+        SYS_HashType         hash;
+        bool                 valid;
+    };
+
+    struct _DiskWrite
+    {
+        UT_StringHolder      path;
+        GT_PrimitiveHandle   prim;
+        GT_RefineParms       refineParms;
+    };
+
+    bool            _GetStageSignature( const UsdStagePtr &stage,
+                                        SYS_HashType &signature );
+    void            _FlushDiskWrites();
+    void            _WriteToDisk( const _DiskWrite &write );
+    void            _TrimDiskCache();
+
     GusdUT_CappedCache _prims;
+    UT_StringHolder    _diskDir;
+    SYS_AtomicInt64    _diskMaxSize;
+    SYS_AtomicInt64    _diskSize;
+    SYS_AtomicInt32    _diskDirInUse;
+    UT_Lock            _diskLock;
+
+    UT_Map<const UsdStage*, _StageSignature> _signatures;
+    UT_Lock            _signatureLock;
+
+    UT_Array<_DiskWrite> _diskWrites;
+    bool               _diskWriting;
+    UT_Lock            _diskWriteLock;
+    UT_TaskGroup       _diskWriteTask;
 };
 
 PXR_NAMESPACE_CLOSE_SCOPE
@@ -1171,6 +1171,21 @@ GusdGU_USD::AppendExpandedPackedPrimsFromLopNode(
         }
     }
 
+    return CopyExpandedAttributes(gd, primDstRng, srcGd,
+                                  srcGd.getIndexMap(srcRng.getOwner()),
+                                  srcOffsets, filter);
+}
+
+
+bool
+GusdGU_USD::CopyExpandedAttributes(
+    GU_Detail& gd,
+    const GA_Range& primDstRng,
+    const GA_Detail& srcGd,
+    const GA_IndexMap& srcMap,
+    const GA_OffsetList& srcOffsets,
+    const GA_AttributeFilter& filter)
+{
     // Find attributes to copy, but exclude special attributes.
     GA_AttributeFilter filterNoRefAttrs(
         GA_AttributeFilter::selectAnd(
@@ -1193,7 +1208,7 @@ GusdGU_USD::AppendExpandedPackedPrimsFromLopNode(
     }
 
     // Create a range for source prims using srcOffsets.
-    GA_Range primSrcRng(srcGd.getIndexMap(srcRng.getOwner()), srcOffsets);
+    GA_Range primSrcRng(srcMap, srcOffsets);
 
     // primDstRng and primSrcRng should be the same size.
     UT_ASSERT(primDstRng.getEntries() == primSrcRng.getEntries());
@@ -1229,6 +1244,16 @@ GusdGU_USD::AppendExpandedPackedPrimsFromLopNode(
 namespace {
 
 
+/// A contiguous block of offsets [start,end) of a range, starting at
+/// @a index within the range.
+struct _OffsetBlock
+{
+    GA_Offset   start;
+    GA_Offset   end;
+    exint       index;
+};
+
+
 bool
 _WriteVariantStrings(GU_Detail& gd,
                      const GA_Range& rng,
@@ -1259,20 +1284,45 @@ _WriteVariantStrings(GU_Detail& gd,
             buf.append(path) : GA_INVALID_STRING_INDEX;
     }
 
-    // Apply the string indices to all of the source offsets.
-    // XXX: could be done in parallel...
-    GA_RWHandleS hnd(attr);
-    
-    char bcnt = 0;
-    exint idx = 0;
-    for(GA_Iterator it(rng); !it.atEnd(); ++it, ++idx) {
-        if(ARCH_UNLIKELY(!++bcnt && boss->opInterrupt()))
-            return false;
-        exint variantIndex = variantIndices(idx);
-        if(variantIndex >= 0)
-            hnd.set(*it, variantIndexToStrMap(variantIndex));
+    // Gather the contiguous blocks of the range, along with the range
+    // index of the start of each block, so that the blocks can be
+    // written in parallel.
+    UT_Array<_OffsetBlock> blocks;
+    {
+        exint idx = 0;
+        GA_Offset start, end;
+        for(GA_Iterator it(rng); it.blockAdvance(start, end); ) {
+            blocks.append({start, end, idx});
+            idx += end - start;
+        }
     }
-    return true;
+
+    // Harden the pages up front, so that threads writing string indices
+    // into disjoint elements never need to unshare a page.
+    attr->hardenAllPages();
+
+    // Apply the string indices to all of the source offsets.
+    // Only string table indices are written, so the table is not modified.
+    UTparallelForLightItems(
+        UT_BlockedRange<exint>(0, blocks.size()),
+        [&](const UT_BlockedRange<exint>& r)
+        {
+            GA_RWHandleS hnd(attr);
+
+            char bcnt = 0;
+            for(exint bi = r.begin(); bi < r.end(); ++bi) {
+                const _OffsetBlock& block = blocks(bi);
+                exint idx = block.index;
+                for(GA_Offset o = block.start; o < block.end; ++o, ++idx) {
+                    if(ARCH_UNLIKELY(!++bcnt && boss->opInterrupt()))
+                        return;
+                    exint variantIndex = variantIndices(idx);
+                    if(variantIndex >= 0)
+                        hnd.set(o, variantIndexToStrMap(variantIndex));
+                }
+            }
+        });
+    return !task.wasInterrupted();
 }
 
 
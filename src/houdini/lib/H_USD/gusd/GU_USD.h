@@ -248,6 +248,18 @@ public:
                             const UT_StringRef &nonTransformingPrimvarPattern,
                             GusdGU_PackedUSD::PivotLocation pivotloc);
 
+    /** Copy attributes matching @a filter from the source prims at
+        @a srcOffsets (one per prim in @a primDstRng) to the prims in
+        @a primDstRng, and to their vertices and points.
+        The path attributes are never copied.*/
+    static bool         CopyExpandedAttributes(
+                            GU_Detail& gd,
+                            const GA_Range& primDstRng,
+                            const GA_Detail& srcGd,
+                            const GA_IndexMap& srcMap,
+                            const GA_OffsetList& srcOffsets,
+                            const GA_AttributeFilter& filter);
+
     /** Apply all variant selections in @a selections to each prim
         in the range, storing the resulting variant path in @a variantsAttr.
         For each source prim, this will first validate that the
@@ -28,11 +28,16 @@
 
 #include "pxr/base/arch/hints.h"
 
+#include <UT/UT_Interrupt.h>
+#include <UT/UT_ParallelUtil.h>
+
 PXR_NAMESPACE_OPEN_SCOPE
 
 GusdUSD_VisCache::GusdUSD_VisCache(GusdStageCache& cache)
   : GusdUSD_DataCache(cache),
-    _visInfos(GUSDUT_USDCACHE_NAME, 256)
+    _visInfos(GUSDUT_USDCACHE_NAME, 256),
+    _timeVisUse(0),
+    _maxTimes(16)
 {}
 
 
@@ -102,6 +107,14 @@ _ShouldCacheVisibility(int flags, UsdTimeCode time)
 }
 
 
+bool
+_ShouldCacheResolvedVisibility(int flags, UsdTimeCode time)
+{
+    // Resolved visibility also varies if any ancestor's visibility does.
+    return !(flags&FLAGS_RESOLVED_ISMAYBETIMEVARYING) || time.IsDefault();
+}
+
+
 } /*namespace*/
 
 
@@ -185,8 +198,91 @@ GusdUSD_VisCache::_GetVisibility(int& flags,
 }
 
 
+GusdUSD_VisCache::TimeVisHandle
+GusdUSD_VisCache::_GetTimeVis(UsdTimeCode time)
+{
+    // Lookups only go through the concurrent map, so parallel traversals
+    // at the same time don't serialize on _timeVisLock.
+    {
+        TimeVisMap::const_accessor a;
+        if (_timeVis.find(a, time.GetValue())) {
+            // Stamp the entry so the least recently used time is evicted.
+            // The stamp only changes when a time is added, so this rarely
+            // writes.
+            const int64 use = _timeVisUse.relaxedLoad();
+            if (a->second->lastUse.relaxedLoad() != use) {
+                a->second->lastUse.relaxedStore(use);
+            }
+            return a->second;
+        }
+    }
+
+    UT_AutoLock lock(_timeVisLock);
+
+    if (_maxTimes <= 0) {
+        return TimeVisHandle();
+    }
+
+    // Another thread may have added the time while we were waiting.
+    TimeVisHandle timeVis;
+    {
+        TimeVisMap::accessor a;
+        if (!_timeVis.insert(a, time.GetValue())) {
+            return a->second;
+        }
+        timeVis.reset(new TimeVis(time));
+        timeVis->lastUse.store(_timeVisUse.add(1));
+        a->second = timeVis;
+    }
+    _timeVisList.append(timeVis);
+    _EvictTimeVis();
+    return timeVis;
+}
+
+
+void
+GusdUSD_VisCache::_EvictTimeVis()
+{
+    while (_timeVisList.size() > _maxTimes) {
+        exint oldest = 0;
+        for (exint i = 1; i < _timeVisList.size(); ++i) {
+            if (_timeVisList(i)->lastUse.relaxedLoad() <
+                _timeVisList(oldest)->lastUse.relaxedLoad()) {
+                oldest = i;
+            }
+        }
+        _timeVis.erase(_timeVisList(oldest)->time.GetValue());
+        _timeVisList.removeIndex(oldest);
+    }
+}
+
+
+void
+GusdUSD_VisCache::_ClearTimeVis()
+{
+    UT_AutoLock lock(_timeVisLock);
+
+    // Erase the entries one at a time, since unlike clear(), erase() is
+    // safe alongside concurrent lookups.
+    for (const TimeVisHandle& timeVis : _timeVisList) {
+        _timeVis.erase(timeVis->time.GetValue());
+    }
+    _timeVisList.clear();
+}
+
+
 bool
 GusdUSD_VisCache::GetResolvedVisibility(const UsdPrim& prim, UsdTimeCode time)
+{
+    TimeVisHandle timeVis;
+    return _GetResolvedVisibility(prim, time, timeVis);
+}
+
+
+bool
+GusdUSD_VisCache::_GetResolvedVisibility(const UsdPrim& prim,
+                                         UsdTimeCode time,
+                                         TimeVisHandle& timeVis)
 {
     auto info = _GetVisInfo(prim);
     if (ARCH_UNLIKELY(!info)) {
@@ -194,7 +290,7 @@ GusdUSD_VisCache::GetResolvedVisibility(const UsdPrim& prim, UsdTimeCode time)
     }
 
     int flags = info->flags.relaxedLoad();
-    if (_ShouldCacheVisibility(flags, time)) {
+    if (_ShouldCacheResolvedVisibility(flags, time)) {
         VisType visType = time.IsDefault() ?
             VIS_UNVARYING_RESOLVED : VIS_VARYING_RESOLVED;
         int stateFlags = _GetStateFlags(flags, visType);
@@ -206,7 +302,7 @@ GusdUSD_VisCache::GetResolvedVisibility(const UsdPrim& prim, UsdTimeCode time)
             if (vis) {
                 if (UsdPrim parent = prim.GetParent()) {
                     if (!parent.IsPseudoRoot()) {
-                        vis = GetResolvedVisibility(parent, time);
+                        vis = _GetResolvedVisibility(parent, time, timeVis);
                     }
                 }
             }
@@ -218,24 +314,82 @@ GusdUSD_VisCache::GetResolvedVisibility(const UsdPrim& prim, UsdTimeCode time)
             return vis;
         }
     } else {
-        // Visibility is not cached when time-varying.
-        if (_QueryVisibility(info->query, time)) {
+        // Varying visibility is cached per time.
+        if (!timeVis) {
+            timeVis = _GetTimeVis(time);
+        }
+        const GusdUSD_UnvaryingPropertyKey key(prim);
+        if (timeVis) {
+            GusdUSD_UnvaryingPropertyMap<bool>::const_accessor a;
+            if (timeVis->resolved.find(a, key)) {
+                return a->second;
+            }
+        }
+
+        // XXX: Concurrent resolves of the same prim may both compute
+        // the value, but will always agree on it.
+        bool vis = _QueryVisibility(info->query, time);
+        if (vis) {
             if (UsdPrim parent = prim.GetParent()) {
                 if (!parent.IsPseudoRoot()) {
-                    return GetResolvedVisibility(parent, time);
+                    vis = _GetResolvedVisibility(parent, time, timeVis);
                 }
             }
-            return true;
         }
-        return false;
+        if (timeVis) {
+            timeVis->resolved.insert(std::make_pair(key, vis));
+        }
+        return vis;
     }
 }
 
 
+bool
+GusdUSD_VisCache::GetResolvedVisibilities(const UT_Array<UsdPrim>& prims,
+                                          UsdTimeCode time,
+                                          bool* vis)
+{
+    UT_AutoInterrupt task("Compute resolved visibility");
+
+    // Share a single time cache across all of the prims, so that common
+    // ancestors are resolved once.
+    const TimeVisHandle sharedTimeVis = _GetTimeVis(time);
+
+    UTparallelFor(
+        UT_BlockedRange<exint>(0, prims.size()),
+        [&](const UT_BlockedRange<exint>& r)
+        {
+            auto* boss = UTgetInterrupt();
+            char bcnt = 0;
+
+            TimeVisHandle timeVis = sharedTimeVis;
+            for (exint i = r.begin(); i < r.end(); ++i) {
+                if (!++bcnt && boss->opInterrupt()) {
+                    return;
+                }
+                vis[i] = prims(i) &&
+                    _GetResolvedVisibility(prims(i), time, timeVis);
+            }
+        });
+    return !task.wasInterrupted();
+}
+
+
+void
+GusdUSD_VisCache::SetMaxCachedTimes(exint maxTimes)
+{
+    UT_AutoLock lock(_timeVisLock);
+
+    _maxTimes = SYSmax(maxTimes, exint(0));
+    _EvictTimeVis();
+}
+
+
 void
 GusdUSD_VisCache::Clear()
 {
     _visInfos.clear();
+    _ClearTimeVis();
 }
 
 
@@ -263,6 +417,9 @@ _RemoveKeysT(const UT_StringSet& paths, GusdUT_CappedCache& cache)
 int64
 GusdUSD_VisCache::Clear(const UT_StringSet& paths)
 {   
+    // Varying visibility is cheap to recompute, so rather than filtering
+    // every time's entries, just drop them all.
+    _ClearTimeVis();
     return _RemoveKeysT<_UnvaryingKey>(paths, _visInfos);
 }
 
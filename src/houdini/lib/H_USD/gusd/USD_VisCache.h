@@ -27,9 +27,14 @@
 #include "gusd/api.h"
 
 #include "gusd/USD_DataCache.h"
+#include "gusd/USD_PropertyMap.h"
 #include "gusd/UT_CappedCache.h"
 
 #include <SYS/SYS_AtomicInt.h>
+#include <SYS/SYS_Hash.h>
+#include <UT/UT_ConcurrentHashMap.h>
+#include <UT/UT_IntrusivePtr.h>
+#include <UT/UT_Lock.h>
 
 #include "pxr/pxr.h"
 #include "pxr/usd/usd/attributeQuery.h"
@@ -38,9 +43,10 @@
 PXR_NAMESPACE_OPEN_SCOPE
 
 /** Thread-safe, memory-capped visibility cache.
-    This does not cache varying visibility state; only unvarying visibility
-    values and information about whether or not visibility might vary
-    with time is cached.*/
+    Unvarying visibility values and information about whether or not
+    visibility might vary with time are cached per prim. Resolved
+    visibility that varies with time is cached per time code, for a
+    bounded number of the most recently queried times.*/
 class GusdUSD_VisCache final : public GusdUSD_DataCache
 {
 public:
@@ -61,6 +67,19 @@ public:
     GUSD_API
     bool    GetResolvedVisibility(const UsdPrim& prim, UsdTimeCode time);
 
+    /** Compute the resolved visibility of multiple prims at a single time,
+        in parallel. Ancestors shared between the prims are only resolved
+        once. Returns false if interrupted.*/
+    GUSD_API
+    bool    GetResolvedVisibilities(const UT_Array<UsdPrim>& prims,
+                                    UsdTimeCode time,
+                                    bool* vis);
+
+    /** Set the number of distinct times for which varying resolved
+        visibility is cached. Zero disables caching of varying visibility.*/
+    GUSD_API
+    void    SetMaxCachedTimes(exint maxTimes);
+
     GUSD_API
     virtual void    Clear() override;
 
@@ -82,8 +101,45 @@ private:
     };
     typedef UT_IntrusivePtr<VisInfo> VisInfoHandle;
 
+    /** Resolved visibility at a single time.*/
+    struct TimeVis : public UT_IntrusiveRefCounter<TimeVis>
+    {
+        TimeVis(UsdTimeCode time) : time(time), lastUse(0) {}
+
+        const UsdTimeCode                   time;
+        SYS_AtomicInt64                     lastUse;
+        GusdUSD_UnvaryingPropertyMap<bool>  resolved;
+    };
+    typedef UT_IntrusivePtr<TimeVis> TimeVisHandle;
+
+    struct TimeHashCmp
+    {
+        static std::size_t  hash(double time)
+                            { return SYShash(time); }
+        static bool         equal(double a, double b)
+                            { return a == b; }
+    };
+    typedef UT_ConcurrentHashMap<double, TimeVisHandle, TimeHashCmp>
+        TimeVisMap;
+
     VisInfoHandle   _GetVisInfo(const UsdPrim& prim);
 
+    /** Return the varying visibility cache for @a time, or null if
+        varying visibility is not being cached.*/
+    TimeVisHandle   _GetTimeVis(UsdTimeCode time);
+
+    /** Evict the least recently used times until at most _maxTimes remain.
+        _timeVisLock must be held.*/
+    void            _EvictTimeVis();
+
+    void            _ClearTimeVis();
+
+    /** Resolve visibility, caching varying visibility in @a timeVis.
+        If null, @a timeVis is looked up when first needed.*/
+    bool            _GetResolvedVisibility(const UsdPrim& prim,
+                                           UsdTimeCode time,
+                                           TimeVisHandle& timeVis);
+
     /** Query visibility. Returns true if @a flags were modified.*/
     bool            _GetVisibility(int& flags,
                                    const UsdAttributeQuery& query,
@@ -91,6 +147,15 @@ private:
                                    bool& vis);
 
     GusdUT_CappedCache  _visInfos;
+
+    /// Varying resolved visibility for the most recently used times.
+    /// Lookups only use the concurrent map. Adding and evicting times is
+    /// guarded by _timeVisLock, as is the list of cached times.
+    TimeVisMap              _timeVis;
+    UT_Array<TimeVisHandle> _timeVisList;
+    SYS_AtomicInt64         _timeVisUse;
+    exint                   _maxTimes;
+    UT_Lock                 _timeVisLock;
 };
 
 PXR_NAMESPACE_CLOSE_SCOPE
@@ -28,6 +28,7 @@
 #include "gusd/UT_CappedCache.h"
 
 #include "pxr/base/arch/hints.h"
+#include "pxr/usd/usd/primRange.h"
 
 #include <UT/UT_Interrupt.h>
 #include <UT/UT_Matrix4.h>
@@ -163,11 +164,23 @@ bool
 GusdUSD_XformCache::GetLocalToWorldTransform(const UsdPrim& prim,
                                              UsdTimeCode time,
                                              UT_Matrix4D& xform)
+{
+    return _GetLocalToWorldTransform(prim, time, xform,
+                                     _hasWorldXformTables.load());
+}
+
+
+bool
+GusdUSD_XformCache::_GetLocalToWorldTransform(const UsdPrim& prim,
+                                              UsdTimeCode time,
+                                              UT_Matrix4D& xform,
+                                              bool findInTables)
 {
     const auto info = GetXformInfo(prim);
     if(ARCH_UNLIKELY(!info)) {
         return false;
     }
+    const UsdTimeCode tableTime = time;
 
     // See if we can remap the time to for unvarying xforms.
     if(!time.IsDefault() && !info->WorldXformIsMaybeTimeVarying()) {
@@ -183,6 +196,9 @@ GusdUSD_XformCache::GetLocalToWorldTransform(const UsdPrim& prim,
         xform = UTverify_cast<const _CappedXformItem*>(item.get())->xform;
         return true;
     }
+    if(findInTables && _FindInWorldXformTables(prim, tableTime, xform)) {
+        return true;
+    }
     /* XXX: Race is possible when setting computed value,
        but it's preferable to have multiple threads compute the
        same thing than to cause lock contention.*/
@@ -195,8 +211,9 @@ GusdUSD_XformCache::GetLocalToWorldTransform(const UsdPrim& prim,
         const UsdPrim parent = prim.GetParent();
         UT_ASSERT_P(parent);
 
+        // If no table holds this prim, none can hold its parent either.
         UT_Matrix4D parentXf;
-        if(GetLocalToWorldTransform(parent, time, parentXf)) {
+        if(_GetLocalToWorldTransform(parent, time, parentXf, false)) {
             xform *= parentXf;
             _worldXforms.addItem(
                 key, UT_CappedItemHandle(new _CappedXformItem(xform)));
@@ -208,11 +225,186 @@ GusdUSD_XformCache::GetLocalToWorldTransform(const UsdPrim& prim,
 
 
 
+int64
+GusdUSD_XformCache::WorldXformTable::getMemoryUsage() const
+{
+    // Approximate the cost of the hash map nodes.
+    return sizeof(*this) +
+        _paths.getMemoryUsage(false) +
+        _xforms.getMemoryUsage(false) +
+        _indices.size()*(sizeof(SdfPath) + sizeof(exint) + 2*sizeof(void*));
+}
+
+
+bool
+GusdUSD_XformCache::_FindInWorldXformTables(const UsdPrim& prim,
+                                            UsdTimeCode time,
+                                            UT_Matrix4D& xform)
+{
+    // Tables are keyed by their root, so look for a table rooted at
+    // the prim or any of its ancestors.
+    for(UsdPrim p = prim; p && !p.IsPseudoRoot(); p = p.GetParent()) {
+        _VaryingKey key(GusdUSD_VaryingPropertyKey(p, time));
+        if(auto item = _worldXformTables.findItem(key)) {
+            return UTverify_cast<const WorldXformTable*>(
+                item.get())->Find(prim, time, xform);
+        }
+    }
+    return false;
+}
+
+
+exint
+GusdUSD_XformCache::WorldXformTable::FindIndex(const SdfPath& path) const
+{
+    const auto it = _indices.find(path);
+    return it != _indices.end() ? it->second : -1;
+}
+
+
+bool
+GusdUSD_XformCache::WorldXformTable::Find(const UsdPrim& prim,
+                                          UsdTimeCode time,
+                                          UT_Matrix4D& xform) const
+{
+    if(time != _time || !prim.GetPath().HasPrefix(_root.GetPath()) ||
+       prim.GetStage() != _root.GetStage()) {
+        return false;
+    }
+    const exint idx = FindIndex(prim.GetPath());
+    if(idx < 0) {
+        return false;
+    }
+    xform = _xforms(idx);
+    return true;
+}
+
+
+GusdUSD_XformCache::WorldXformTableHandle
+GusdUSD_XformCache::GetLocalToWorldTransformTable(const UsdPrim& root,
+                                                  UsdTimeCode time)
+{
+    if(!root || root.IsPseudoRoot()) {
+        return nullptr;
+    }
+
+    _VaryingKey key(GusdUSD_VaryingPropertyKey(root, time));
+    if(auto item = _worldXformTables.findItem(key)) {
+        return WorldXformTableHandle(
+            UTverify_cast<const WorldXformTable*>(item.get()));
+    }
+
+    UT_AutoInterrupt task("Compute world transforms");
+    auto* boss = UTgetInterrupt();
+
+    auto* table = new WorldXformTable(root, time);
+    WorldXformTableHandle handle(table);
+
+    // Gather the prims depth-first, along with the index of the parent
+    // of each, grouping the prims by depth for the top-down pass.
+    UT_Array<exint> parents;
+    UT_Array<UT_Array<exint> > levels;
+    UT_Array<UsdPrim> prims;
+    {
+        UT_Array<exint> depths;
+        char bcnt = 0;
+        for(const UsdPrim& prim :
+                UsdPrimRange(root, UsdTraverseInstanceProxies())) {
+            if(!++bcnt && boss->opInterrupt()) {
+                return nullptr;
+            }
+
+            const exint idx = prims.size();
+            exint parent = -1, depth = 0;
+            if(idx > 0) {
+                parent = table->FindIndex(prim.GetPath().GetParentPath());
+                UT_ASSERT_P(parent >= 0);
+                depth = depths(parent) + 1;
+            }
+
+            prims.append(prim);
+            parents.append(parent);
+            depths.append(depth);
+            table->_paths.append(prim.GetPath());
+            table->_indices.emplace(prim.GetPath(), idx);
+
+            if(depth >= levels.size()) {
+                levels.setSize(depth+1);
+            }
+            levels(depth).append(idx);
+        }
+    }
+
+    const exint n = prims.size();
+    table->_xforms.setSize(n);
+
+    // Compute local transforms in parallel.
+    UT_Array<bool> resetsXformStack;
+    resetsXformStack.setSize(n);
+    UTparallelFor(
+        UT_BlockedRange<exint>(0, n),
+        [&](const UT_BlockedRange<exint>& r)
+        {
+            for(exint i = r.begin(); i < r.end(); ++i) {
+                UT_Matrix4D& xform = table->_xforms(i);
+                bool resets = false;
+                UsdGeomXformable xformable(prims(i));
+                if(!xformable ||
+                   !xformable.GetLocalTransformation(
+                       GusdUT_Gf::Cast(&xform), &resets, time)) {
+                    xform.identity();
+                    resets = false;
+                }
+                resetsXformStack(i) = resets;
+            }
+        });
+
+    // The root is relative to its parent's world transform, which is
+    // computed by the per-prim path.
+    if(!resetsXformStack(0)) {
+        const UsdPrim parent = root.GetParent();
+        UT_Matrix4D parentXf;
+        if(parent && !parent.IsPseudoRoot() &&
+           GetLocalToWorldTransform(parent, time, parentXf)) {
+            table->_xforms(0) *= parentXf;
+        }
+    }
+
+    // Accumulate transforms top-down, one depth level at a time.
+    for(exint d = 1; d < levels.size(); ++d) {
+        if(boss->opInterrupt()) {
+            return nullptr;
+        }
+        const UT_Array<exint>& level = levels(d);
+        UTparallelForLightItems(
+            UT_BlockedRange<exint>(0, level.size()),
+            [&](const UT_BlockedRange<exint>& r)
+            {
+                for(exint i = r.begin(); i < r.end(); ++i) {
+                    const exint idx = level(i);
+                    if(!resetsXformStack(idx)) {
+                        table->_xforms(idx) *= table->_xforms(parents(idx));
+                    }
+                }
+            });
+    }
+
+    // Tables are held by a capped cache, so that they count against its
+    // memory limit and are evicted like any other cached transforms.
+    _worldXformTables.addItem(key, UT_CappedItemHandle(table));
+    _hasWorldXformTables.store(1);
+    return handle;
+}
+
+
+
 GusdUSD_XformCache::GusdUSD_XformCache(GusdStageCache& cache)
     : GusdUSD_DataCache(cache),
       _xforms(GUSDUT_USDCACHE_NAME, 512),
       _worldXforms(GUSDUT_USDCACHE_NAME, 512),
-      _xformInfos(GUSDUT_USDCACHE_NAME, 256) {}
+      _xformInfos(GUSDUT_USDCACHE_NAME, 256),
+      _worldXformTables(GUSDUT_USDCACHE_NAME, 512),
+      _hasWorldXformTables(0) {}
 
     
 GusdUSD_XformCache::GusdUSD_XformCache()
@@ -437,6 +629,8 @@ GusdUSD_XformCache::Clear()
     _xforms.clear();
     _worldXforms.clear();
     _xformInfos.clear();
+    _worldXformTables.clear();
+    _hasWorldXformTables.store(0);
 }
 
 
@@ -466,7 +660,8 @@ GusdUSD_XformCache::Clear(const UT_StringSet& paths)
 {   
     return _RemoveKeysT<_VaryingKey>(paths, _xforms) +
            _RemoveKeysT<_VaryingKey>(paths, _worldXforms ) +
-           _RemoveKeysT<_UnvaryingKey>(paths, _xformInfos);
+           _RemoveKeysT<_UnvaryingKey>(paths, _xformInfos) +
+           _RemoveKeysT<_VaryingKey>(paths, _worldXformTables);
 }
 
 PXR_NAMESPACE_CLOSE_SCOPE
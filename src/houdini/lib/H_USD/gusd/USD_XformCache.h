@@ -34,6 +34,10 @@
 #include "pxr/pxr.h"
 #include "pxr/usd/usdGeom/xformable.h"
 
+#include <SYS/SYS_AtomicInt.h>
+
+#include <unordered_map>
+
 PXR_NAMESPACE_OPEN_SCOPE
 
 /** Concurrent memory-capped cache for primitive transforms.*/
@@ -124,6 +128,59 @@ public:
     GUSD_API
     XformInfoHandle GetXformInfo(const UsdPrim& prim);
 
+    /** Flattened world transforms of a prim and all of its descendants,
+        at a single time. Transforms are stored contiguously, in the
+        depth-first order of the prims.*/
+    class WorldXformTable : public UT_CappedItem
+    {
+    public:
+        WorldXformTable(const UsdPrim& root, UsdTimeCode time)
+            : UT_CappedItem(), _root(root), _time(time) {}
+
+        virtual ~WorldXformTable() {}
+
+        virtual int64       getMemoryUsage() const override;
+
+        const UsdPrim&      GetRoot() const         { return _root; }
+        UsdTimeCode         GetTime() const         { return _time; }
+
+        exint               GetNumXforms() const    { return _xforms.size(); }
+
+        const SdfPath&      GetPath(exint i) const  { return _paths(i); }
+        const UT_Matrix4D&  GetXform(exint i) const { return _xforms(i); }
+
+        /** Return the index of the transform of the prim at @a path,
+            or -1 if the prim is not in this table.*/
+        exint               FindIndex(const SdfPath& path) const;
+
+        /** Return true if this table holds the transform of @a prim
+            at @a time, copying it to @a xform.*/
+        bool                Find(const UsdPrim& prim,
+                                 UsdTimeCode time,
+                                 UT_Matrix4D& xform) const;
+
+    private:
+        const UsdPrim                                       _root;
+        const UsdTimeCode                                   _time;
+        UT_Array<SdfPath>                                   _paths;
+        UT_Array<UT_Matrix4D>                               _xforms;
+        std::unordered_map<SdfPath, exint, SdfPath::Hash>   _indices;
+
+        friend class GusdUSD_XformCache;
+    };
+    typedef UT_IntrusivePtr<const WorldXformTable> WorldXformTableHandle;
+
+    /** Compute the world transforms of @a root and all of its descendants
+        (including instance proxies) at @a time, in a single top-down
+        parallel pass. The table is retained by the cache, counting against
+        its memory limit, and world transform queries for any prim in the
+        table are answered from it until it is evicted or cleared.
+        This is much cheaper than per-prim queries when transforms are
+        needed for most of a large hierarchy.*/
+    GUSD_API
+    WorldXformTableHandle   GetLocalToWorldTransformTable(const UsdPrim& root,
+                                                          UsdTimeCode time);
+
     GUSD_API
     virtual void    Clear() override;
 
@@ -135,11 +192,27 @@ private:
                                     UsdTimeCode time,
                                     UT_Matrix4D& xform,
                                     const XformInfoHandle& info);
+
+    bool    _GetLocalToWorldTransform(const UsdPrim& prim,
+                                      UsdTimeCode time,
+                                      UT_Matrix4D& xform,
+                                      bool findInTables);
+
+    bool    _FindInWorldXformTables(const UsdPrim& prim,
+                                    UsdTimeCode time,
+                                    UT_Matrix4D& xform);
                                     
 
 
 private:
     GusdUT_CappedCache  _xforms, _worldXforms, _xformInfos;
+
+    /// World transform tables, keyed by their root prim and time.
+    GusdUT_CappedCache  _worldXformTables;
+
+    /// Set once a table has been added, so that per-prim lookups only
+    /// search for tables when there may be some.
+    SYS_AtomicInt32     _hasWorldXformTables;
 };
 
 PXR_NAMESPACE_CLOSE_SCOPE
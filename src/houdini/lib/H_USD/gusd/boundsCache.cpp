@@ -23,6 +23,9 @@
 //
 #include "boundsCache.h"
 
+#include <UT/UT_Interrupt.h>
+#include <UT/UT_ParallelUtil.h>
+
 #include <iostream>
 
 PXR_NAMESPACE_OPEN_SCOPE
@@ -48,6 +51,26 @@ GusdBoundsCache::~GusdBoundsCache()
 {
 }
 
+GusdBoundsCache::Item::~Item()
+{
+    for( auto it = bboxCaches.begin(); it != bboxCaches.end(); ++it ) {
+        delete it.get();
+    }
+}
+
+UsdGeomBBoxCache&
+GusdBoundsCache::Item::GetCache( UsdTimeCode time )
+{
+    UsdGeomBBoxCache*& cache = bboxCaches.get();
+    if( !cache ) {
+        cache = new UsdGeomBBoxCache( time, purposes );
+    }
+    else {
+        cache->SetTime( time );
+    }
+    return *cache;
+}
+
 bool 
 GusdBoundsCache::ComputeWorldBound(
     const UsdPrim &prim,
@@ -78,6 +101,62 @@ GusdBoundsCache::ComputeUntransformedBound(
                 bounds );
 }
 
+bool 
+GusdBoundsCache::ComputeWorldBounds(
+    const UT_Array<UsdPrim> &prims,
+    UsdTimeCode time,
+    const TfTokenVector &includedPurposes,
+    UT_Array<UT_BoundingBox> &bounds )
+{
+    return _ComputeBounds(
+                prims,
+                time,
+                includedPurposes,
+                &UsdGeomBBoxCache::ComputeWorldBound,
+                bounds );
+}
+
+bool 
+GusdBoundsCache::ComputeUntransformedBounds(
+    const UT_Array<UsdPrim> &prims,
+    UsdTimeCode time,
+    const TfTokenVector &includedPurposes,
+    UT_Array<UT_BoundingBox> &bounds )
+{
+    return _ComputeBounds(
+                prims,
+                time,
+                includedPurposes,
+                &UsdGeomBBoxCache::ComputeUntransformedBound,
+                bounds );
+}
+
+GusdBoundsCache::ItemHandle
+GusdBoundsCache::_GetItem(
+    const UsdStagePtr &stage,
+    const TfTokenVector &includedPurposes )
+{
+    TfToken stageId( stage->GetRootLayer()->IsAnonymous()
+	    ? stage->GetRootLayer()->GetIdentifier()
+	    : stage->GetRootLayer()->GetRealPath() );
+    Key key( stageId, includedPurposes );
+
+    // Only hold the map lock long enough to look up the item. The
+    // item itself is safe to use from multiple threads.
+    {
+        MapType::const_accessor accessor;
+        if( m_map.find( accessor, key )) {
+            return accessor->second;
+        }
+    }
+
+    MapType::accessor accessor;
+    if( m_map.insert( accessor, key )) {
+        accessor->second = new Item( includedPurposes );
+    }
+    return accessor->second;
+}
+
 bool 
 GusdBoundsCache::_ComputeBound(
     const UsdPrim &prim,
@@ -89,22 +168,73 @@ GusdBoundsCache::_ComputeBound(
     if( !prim.IsValid() )
         return false;
 
-    TfToken stageId( prim.GetStage()->GetRootLayer()->IsAnonymous()
-	    ? prim.GetStage()->GetRootLayer()->GetIdentifier()
-	    : prim.GetStage()->GetRootLayer()->GetRealPath() );
+    ItemHandle item = _GetItem( prim.GetStage(), includedPurposes );
+    return _ComputeBound( *item, prim, time, boundFunc, bounds );
+}
 
-    MapType::accessor accessor;
-    if( !m_map.find( accessor, Key( stageId, includedPurposes ))) {
-        m_map.insert( accessor, Key( stageId, includedPurposes ) );
-        accessor->second = new Item( time, includedPurposes );
-    }
-    std::lock_guard<std::mutex> lock(accessor->second->lock);
-    UsdGeomBBoxCache& cache = accessor->second->bboxCache;
+bool
+GusdBoundsCache::_ComputeBounds(
+    const UT_Array<UsdPrim> &prims,
+    UsdTimeCode time,
+    const TfTokenVector &includedPurposes,
+    ComputeFunc boundFunc,
+    UT_Array<UT_BoundingBox> &bounds )
+{
+    bounds.setSizeNoInit( prims.size() );
+
+    UTparallelFor( UT_BlockedRange<exint>( 0, prims.size() ),
+        [&]( const UT_BlockedRange<exint>& r )
+        {
+            auto* boss = UTgetInterrupt();
+            char bcnt = 0;
 
-    cache.SetTime( time );
+            // Prims in a batch usually come from a single stage, so
+            // avoid looking up the item for every prim.
+            UsdStagePtr stage;
+            ItemHandle item;
+
+            for( exint i = r.begin(); i < r.end(); ++i ) {
+                if( !++bcnt && boss->opInterrupt() )
+                    return;
+
+                const UsdPrim& prim = prims(i);
+                if( !prim.IsValid() ) {
+                    bounds(i).makeInvalid();
+                    continue;
+                }
+                if( !item || prim.GetStage() != stage ) {
+                    stage = prim.GetStage();
+                    item = _GetItem( stage, includedPurposes );
+                }
+                if( !_ComputeBound( *item, prim, time, boundFunc, bounds(i) )) {
+                    bounds(i).makeInvalid();
+                }
+            }
+        });
+
+    return !UTgetInterrupt()->opInterrupt();
+}
+
+bool 
+GusdBoundsCache::_ComputeBound(
+    Item &item,
+    const UsdPrim &prim,
+    UsdTimeCode time,
+    ComputeFunc boundFunc,
+    UT_BoundingBox &bounds )
+{
+    GfBBox3d primBBox;
+
+    // UsdGeomBBoxCache spawns its own tasks. Isolate them so this thread
+    // can't pick up another bounds query while waiting, which would
+    // re-enter this thread's cache.
+    UTisolate( [&]()
+    {
+        UsdGeomBBoxCache& cache = item.GetCache( time );
 
-    // boundFunc is either ComputeWorldBound or ComputeLocalBound
-    GfBBox3d primBBox = (cache.*boundFunc)(prim);
+        // boundFunc is either ComputeWorldBound or ComputeLocalBound
+        primBBox = (cache.*boundFunc)(prim);
+    });
 
     if( !primBBox.GetRange().IsEmpty() ) 
     {
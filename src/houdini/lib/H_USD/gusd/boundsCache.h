@@ -31,9 +31,11 @@
 
 #include "USD_DataCache.h"
 
+#include <UT/UT_Array.h>
 #include <UT/UT_BoundingBox.h>
 #include <UT/UT_IntrusivePtr.h>
 #include <UT/UT_ConcurrentHashMap.h>
+#include <UT/UT_ThreadSpecificValue.h>
 
 PXR_NAMESPACE_OPEN_SCOPE
 
@@ -45,6 +47,11 @@ PXR_NAMESPACE_OPEN_SCOPE
 /// Unfortunaly UsdGeomBBoxCaches only store a single frame at
 /// a time. I considered creating a cache per frame but I thought
 /// that would defeat optimizations for non animated geometry.
+///
+/// UsdGeomBBoxCaches are not thread safe, so each thread gets its own
+/// cache for every (stage, purposes) key. This lets bounds queries on
+/// prims from the same stage run concurrently, at the cost of some
+/// duplicated work between threads.
 
 class GusdBoundsCache : public GusdUSD_DataCache {
 public:
@@ -65,6 +72,22 @@ public:
             const TfTokenVector &includedPurposes,
             UT_BoundingBox &bounds );
 
+    /// Batched versions of the above, computing the bounds of all @a prims
+    /// in parallel. @a bounds is resized to match @a prims. Any prim that
+    /// has no bounds gets an invalid box (see UT_BoundingBox::isValid()).
+    /// Returns false if the operation was interrupted.
+    bool ComputeWorldBounds(
+            const UT_Array<UsdPrim> &prims,
+            UsdTimeCode time,
+            const TfTokenVector &includedPurposes,
+            UT_Array<UT_BoundingBox> &bounds );
+
+    bool ComputeUntransformedBounds(
+            const UT_Array<UsdPrim> &prims,
+            UsdTimeCode time,
+            const TfTokenVector &includedPurposes,
+            UT_Array<UT_BoundingBox> &bounds );
+
     virtual void Clear() override;
     virtual int64 Clear(const UT_StringSet& stageNames) override;
 
@@ -108,16 +131,26 @@ private:
 
     struct Item : public UT_IntrusiveRefCounter<Item>
     {
-        Item( UsdTimeCode time, const TfTokenVector& includedPurposes ) 
-            : bboxCache( time, includedPurposes )
+        Item( const TfTokenVector& includedPurposes ) 
+            : purposes( includedPurposes )
         {
         }
-        
-        UsdGeomBBoxCache bboxCache;
-        std::mutex lock;
+        ~Item();
+
+        /// Return the bbox cache owned by the calling thread,
+        /// set to the given time.
+        UsdGeomBBoxCache& GetCache( UsdTimeCode time );
+
+        TfTokenVector purposes;
+        UT_ThreadSpecificValue<UsdGeomBBoxCache*> bboxCaches;
     };
 
     typedef GfBBox3d (UsdGeomBBoxCache::*ComputeFunc)(const UsdPrim& prim);
+    typedef UT_IntrusivePtr<Item> ItemHandle;
+
+    ItemHandle _GetItem(
+            const UsdStagePtr &stage,
+            const TfTokenVector &includedPurposes );
 
     bool _ComputeBound(
             const UsdPrim &prim,
@@ -126,7 +159,19 @@ private:
             ComputeFunc boundFunc,
             UT_BoundingBox &bounds );   
 
-    typedef UT_IntrusivePtr<Item> ItemHandle;
+    bool _ComputeBound(
+            Item &item,
+            const UsdPrim &prim,
+            UsdTimeCode time,
+            ComputeFunc boundFunc,
+            UT_BoundingBox &bounds );   
+
+    bool _ComputeBounds(
+            const UT_Array<UsdPrim> &prims,
+            UsdTimeCode time,
+            const TfTokenVector &includedPurposes,
+            ComputeFunc boundFunc,
+            UT_Array<UT_BoundingBox> &bounds );
 
     typedef UT_ConcurrentHashMap<Key,ItemHandle,Key::HashCmp> MapType;
     MapType   m_map;
@@ -36,7 +36,9 @@
 #include <GT/GT_GEODetail.h>
 #include <GT/GT_GEOPrimPacked.h>
 #include <GT/GT_PrimInstance.h>
+#include <SYS/SYS_AtomicInt.h>
 #include <SYS/SYS_Types.h>
+#include <UT/UT_ParallelUtil.h>
 
 #include <iostream>
 
@@ -89,9 +91,61 @@ GusdRefiner::GusdRefiner(
     , m_isTopLevel( true )
     , m_buildPointInstancer( false )
     , m_buildPrototypes( false )
+    , m_pointInstancerTypeSet( false )
 {
 }
 
+GusdRefiner::GusdRefiner(
+    GusdRefinerCollector&   collector,
+    const GusdRefiner&      src )
+    : m_refinePackedPrims( src.m_refinePackedPrims )
+    , m_useUSDIntrinsicNames( src.m_useUSDIntrinsicNames )
+    , m_forceGroupTopPackedPrim( src.m_forceGroupTopPackedPrim )
+    , m_buildPointInstancer( src.m_buildPointInstancer )
+    , m_buildPrototypes( src.m_buildPrototypes )
+    , m_pointInstancerType( src.m_pointInstancerType )
+    , m_writeCtrlFlags( src.m_writeCtrlFlags )
+    , m_collector( collector )
+    , m_refineParms( src.m_refineParms )
+    , m_pathPrefix( src.m_pathPrefix )
+    , m_pathAttrName( src.m_pathAttrName )
+    , m_localToWorldXform( src.m_localToWorldXform )
+    , m_isTopLevel( src.m_isTopLevel )
+    , m_pointInstancerTypeSet( false )
+{
+}
+
+template <typename FUNC>
+void
+GusdRefiner::refineInParallel( exint n, const FUNC& func )
+{
+    std::vector<GusdRefinerCollector> collectors( n );
+    std::vector<TfToken> pointInstancerTypes( n );
+    std::vector<char> pointInstancerTypeSet( n, 0 );
+
+    UTparallelForEachNumber( n, [&]( const UT_BlockedRange<exint>& r )
+    {
+        for( exint i = r.begin(); i < r.end(); ++i ) {
+            collectors[i].setRecording( true );
+
+            GusdRefiner refiner( collectors[i], *this );
+            func( refiner, i );
+
+            pointInstancerTypes[i] = refiner.m_pointInstancerType;
+            pointInstancerTypeSet[i] = refiner.m_pointInstancerTypeSet;
+        }
+    });
+
+    // Replay in order so the results match a serial refine.
+    for( exint i = 0; i < n; ++i ) {
+        m_collector.replay( collectors[i] );
+        if( pointInstancerTypeSet[i] ) {
+            m_pointInstancerType = pointInstancerTypes[i];
+            m_pointInstancerTypeSet = true;
+        }
+    }
+}
+
 void
 GusdRefiner::refineDetail(
     const GU_ConstDetailHandle& detail,
@@ -134,11 +188,8 @@ GusdRefiner::refineDetail(
     
     // Refine each geometry partition to prims that can be written to USD. 
     // The results are accumulated in buffer in the refiner.
-    for(vector<GA_Range>::const_iterator rangeIt=partitions.begin();
-            rangeIt != partitions.end(); ++rangeIt) {
-
-        const GA_Range& range = *rangeIt;
-
+    auto refinePartition = [&]( GusdRefiner& refiner, const GA_Range& range )
+    {
         // Before we refine we need to decide if we want to coalesce packed
         // fragments. We will coalesce unless we are writing transform
         // overlays and the fragment has a name.
@@ -175,8 +226,19 @@ GusdRefiner::refineDetail(
         GT_PrimitiveHandle detailPrim
                 = GT_GEODetail::makeDetail( detail, &range);
         if(detailPrim) {
-            detailPrim->refine(*this, &newRefineParms );
+            detailPrim->refine( refiner, &newRefineParms );
         }
+    };
+
+    if( partitions.size() > 1 ) {
+        refineInParallel( partitions.size(),
+            [&]( GusdRefiner& refiner, exint i )
+            {
+                refinePartition( refiner, partitions[i] );
+            });
+    }
+    else if( !partitions.empty() ) {
+        refinePartition( *this, partitions[0] );
     }
 }
 
@@ -294,6 +356,7 @@ GusdRefiner::addPrimitive( const GT_PrimitiveHandle& gtPrimIn )
                     packedUSD->getFileName(), instancerPrimPath).first) {
                     // Get the type name of the usd file to overlay
                     m_pointInstancerType = prim.GetTypeName();
+                    m_pointInstancerTypeSet = true;
             
                     // Make sure to set buildPointInstancer to true if we are overlaying a
                     // point instancer
@@ -432,15 +495,15 @@ GusdRefiner::addPrimitive( const GT_PrimitiveHandle& gtPrimIn )
             // USD. If it doesn't have a name, we just accumulate the transform and recurse.
 
             auto packedGeo = UTverify_cast<const GT_GEOPrimPacked*>(geometry.get());
-            for( GT_Size i = 0; i < inst->transforms()->entries(); ++i ) {
-
+            auto refineInstance = [&]( GusdRefiner& refiner, GT_Size i )
+            {
                 UT_Matrix4D m;
                 inst->transforms()->get(i)->getMatrix(m);
 
-                UT_Matrix4D newCtm = m_localToWorldXform;
-                newCtm = m* m_localToWorldXform;
+                UT_Matrix4D newCtm = refiner.m_localToWorldXform;
+                newCtm = m* refiner.m_localToWorldXform;
 
-                SdfPath newPath = m_pathPrefix;
+                SdfPath newPath = refiner.m_pathPrefix;
                 bool recurse = true;
 
                 if( primHasNameAttr || 
@@ -451,7 +514,7 @@ GusdRefiner::addPrimitive( const GT_PrimitiveHandle& gtPrimIn )
                     // level group. Here we make sure that we create that group, even 
                     // if the user hasn't named it.
 
-                    newPath = m_collector.add(  SdfPath(primPath), 
+                    newPath = refiner.m_collector.add(  SdfPath(primPath), 
                                                 addNumericSuffix,
                                                 gtPrim,
                                                 newCtm,
@@ -465,7 +528,7 @@ GusdRefiner::addPrimitive( const GT_PrimitiveHandle& gtPrimIn )
 
                 if( recurse ) {
                     GusdRefiner childRefiner(
-                                    m_collector,
+                                    refiner.m_collector,
                                     newPath,
                                     m_pathAttrName,
                                     newCtm );
@@ -479,6 +542,14 @@ GusdRefiner::addPrimitive( const GT_PrimitiveHandle& gtPrimIn )
 
                     childRefiner.refineDetail( packedGeo->getPackedDetail(), m_refineParms );
                 }
+            };
+
+            const GT_Size numInstances = inst->transforms()->entries();
+            if( numInstances > 1 ) {
+                refineInParallel( numInstances, refineInstance );
+            }
+            else if( numInstances == 1 ) {
+                refineInstance( *this, 0 );
             }
             return;
         }
@@ -511,6 +582,52 @@ GusdRefiner::addPrimitive( const GT_PrimitiveHandle& gtPrimIn )
     }
 }
 
+void
+GusdRefinerCollector::replay( const GusdRefinerCollector& recording )
+{
+    if( m_recording ) {
+        m_recordedCalls.insert( m_recordedCalls.end(),
+                                recording.m_recordedCalls.begin(),
+                                recording.m_recordedCalls.end() );
+        return;
+    }
+
+    for( const RecordedCall& call : recording.m_recordedCalls ) {
+        // Paths recorded under a placeholder are moved to the real path of
+        // the placeholder, which is always replayed before its children.
+        SdfPath path = resolvePlaceholder( call.path );
+
+        if( call.isInstPrim ) {
+            addInstPrim( path, call.prim, call.index );
+        }
+        else {
+            m_placeholderPaths[call.placeholder] =
+                add( path, call.addNumericSuffix, call.prim, call.xform,
+                     call.purpose, call.writeCtrlFlags );
+        }
+    }
+}
+
+SdfPath
+GusdRefinerCollector::resolvePlaceholder( const SdfPath& path ) const
+{
+    if( m_placeholderPaths.empty() || !path.IsAbsolutePath() ) {
+        return path;
+    }
+
+    // Placeholders are always root prims.
+    SdfPath root = path;
+    while( root.GetPathElementCount() > 1 ) {
+        root = root.GetParentPath();
+    }
+
+    auto it = m_placeholderPaths.find( root );
+    if( it == m_placeholderPaths.end() ) {
+        return path;
+    }
+    return path.ReplacePrefix( root, it->second );
+}
+
 SdfPath
 GusdRefinerCollector::add( 
     const SdfPath&              path,
@@ -520,6 +637,25 @@ GusdRefinerCollector::add(
     const TfToken &             purpose,
     const GusdWriteCtrlFlags&   writeCtrlFlagsIn )
 {
+    if( m_recording ) {
+        static SYS_AtomicInt64 thePlaceholderCount( 0 );
+
+        RecordedCall call;
+        call.path = path;
+        call.placeholder = SdfPath( TfStringPrintf(
+            "/__gusdRefinerPlaceholder%" SYS_PRId64,
+            thePlaceholderCount.add( 1 )));
+        call.prim = prim;
+        call.xform = xform;
+        call.purpose = purpose;
+        call.writeCtrlFlags = writeCtrlFlagsIn;
+        call.index = 0;
+        call.addNumericSuffix = addNumericSuffix;
+        call.isInstPrim = false;
+        m_recordedCalls.push_back( call );
+        return call.placeholder;
+    }
+
     // Update the write control flags from the attributes on the prim
     GusdWriteCtrlFlags writeCtrlFlags = writeCtrlFlagsIn;
 
@@ -776,6 +912,17 @@ GusdRefinerCollector::addInstPrim( const SdfPath &path, GT_PrimitiveHandle p, in
 
     DBG(cerr << "addInstPrim " << path << endl);
 
+    if( m_recording ) {
+        RecordedCall call;
+        call.path = path;
+        call.prim = p;
+        call.index = index;
+        call.addNumericSuffix = false;
+        call.isInstPrim = true;
+        m_recordedCalls.push_back( call );
+        return;
+    }
+
     auto instPrimsIt = m_instancePrims.find( path );
     if( instPrimsIt == m_instancePrims.end() ) {
         m_instancePrims[ path ] = 
@@ -60,6 +60,15 @@ PXR_NAMESPACE_OPEN_SCOPE
 /// The gprim array can contain prims from several OBJ nodes. The obj nodes provide
 /// a coordinate space and a set of options. We stash this stuff with the prims
 /// in the prim array.
+///
+/// Independent pieces of geometry (the partitions of a detail, and the
+/// instances of a packed prim) are refined in parallel. Each piece is refined
+/// into its own recording collector, and the recordings are replayed into the
+/// main collector in the same order a serial refine would have added them, so
+/// the resulting gprim array (including generated names) is identical to the
+/// serial result. GT itself is not allowed to thread the refinement of a
+/// single piece, since that would make the order of added prims
+/// non-deterministic.
 
 
 class GusdRefinerCollector;
@@ -109,6 +118,12 @@ public:
         const std::string&      pathAttrName,
         const UT_Matrix4D&      localToWorldXform );
 
+    /// Construct a refiner with the same settings as \p src, but which
+    /// adds its prims to a different collector.
+    GusdRefiner(
+        GusdRefinerCollector&   collector,
+        const GusdRefiner&      src );
+
     virtual ~GusdRefiner() {}
 
     virtual bool allowThreading() const override { return false; }
@@ -162,6 +177,12 @@ private:
     // modifying to be a valid Usd prim path.
     std::string createPrimPath( const std::string& primName);
 
+    // Call func(refiner, i) for each i in [0, n) in parallel. Each call gets
+    // a copy of this refiner which records into its own collector. The
+    // recordings are then replayed into our collector in index order.
+    template <typename FUNC>
+    void refineInParallel( exint n, const FUNC& func );
+
     // Place to collect refined prims
     GusdRefinerCollector&   m_collector;
 
@@ -179,6 +200,9 @@ private:
 
     // false if we have recursed into a packed prim.
     bool                    m_isTopLevel;
+
+    // true if m_pointInstancerType has been set by this refiner.
+    bool                    m_pointInstancerTypeSet;
 };
 
 // As we recurse down a packed prim hierarchy, we create a new refiner at each
@@ -212,6 +236,18 @@ public:
 
     ////////////////////////////////////////////////////////////////////////////
 
+    GusdRefinerCollector() : m_recording( false ) {}
+
+    // Record calls to add and addInstPrim instead of processing them. Paths
+    // returned by add are placeholders which are mapped to the real paths
+    // when the recording is replayed.
+    void setRecording( bool recording ) { m_recording = recording; }
+
+    // Process the calls recorded by another collector, in the order they
+    // were made. If this collector is also recording, the calls are simply
+    // appended to our recording.
+    void replay( const GusdRefinerCollector& recording );
+
     SdfPath add( 
         const SdfPath&              path,
         bool                        explicitPrimPath,
@@ -242,6 +278,30 @@ public:
     // sort the prims. If a prim does note have a srcPrimPath, it is added to 
     // a entry with a empty path.
     std::map<SdfPath,std::vector<InstPrimEntry>> m_instancePrims;
+
+private:
+
+    // A call to add or addInstPrim made on a recording collector.
+    struct RecordedCall {
+        SdfPath             path;
+        SdfPath             placeholder;
+        GT_PrimitiveHandle  prim;
+        UT_Matrix4D         xform;
+        TfToken             purpose;
+        GusdWriteCtrlFlags  writeCtrlFlags;
+        int                 index;
+        bool                addNumericSuffix;
+        bool                isInstPrim;
+    };
+
+    // Replace a placeholder prefix in path with the real path it maps to.
+    SdfPath resolvePlaceholder( const SdfPath& path ) const;
+
+    bool                        m_recording;
+    std::vector<RecordedCall>   m_recordedCalls;
+
+    // Map from placeholder paths to the paths they were replayed to.
+    std::map<SdfPath,SdfPath>   m_placeholderPaths;
 };
 
 PXR_NAMESPACE_CLOSE_SCOPE
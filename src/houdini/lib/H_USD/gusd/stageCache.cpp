@@ -29,6 +29,7 @@
 #include <UT/UT_Exit.h>
 #include <UT/UT_Interrupt.h>
 #include <UT/UT_Lock.h>
+#include <UT/UT_Map.h>
 #include <UT/UT_ParallelUtil.h>
 #include <UT/UT_RWLock.h>
 #include <UT/UT_String.h>
@@ -37,11 +38,13 @@
 #include <UT/UT_Thread.h>
 #include <UT/UT_WorkArgs.h>
 #include <UT/UT_WorkBuffer.h>
+#include <SYS/SYS_AtomicInt.h>
 
 #include "gusd/debugCodes.h"
 #include "gusd/error.h"
 #include "gusd/USD_DataCache.h"
 
+#include "pxr/base/arch/fileSystem.h"
 #include "pxr/base/arch/hints.h"
 #include "pxr/base/tf/envSetting.h"
 #include "pxr/base/tf/notice.h"
@@ -55,6 +58,7 @@
 #include "pxr/usd/usd/primRange.h"
 #include "pxr/usd/usd/stagePopulationMask.h"
 
+#include <algorithm>
 #include <atomic>
 
 PXR_NAMESPACE_OPEN_SCOPE
@@ -83,6 +87,21 @@ TF_DEFINE_ENV_SETTING(GUSD_STAGEMASK_ENABLE, true,
                       "(or other types of stage edits).");
 
 
+TF_DEFINE_ENV_SETTING(GUSD_STAGECACHE_PARALLEL_PRIMS_THRESHOLD, 4096,
+                      "Minimum number of prims to look up on a stage at once "
+                      "before the lookups are split across threads. Smaller "
+                      "lookups are done serially, since the threading "
+                      "overhead outweighs the cost of the lookups.");
+
+
+TF_DEFINE_ENV_SETTING(GUSD_STAGECACHE_MEMORY_BUDGET, 0,
+                      "Initial memory budget of the stage cache, in megabytes. "
+                      "When non-zero, trimming the cache evicts the least "
+                      "recently used stages that are not referenced outside "
+                      "of the cache until the estimated memory use of the "
+                      "remaining stages is within this budget.");
+
+
 namespace {
 
 GusdLopStageResolver theLopStageResolver = nullptr;
@@ -292,6 +311,25 @@ public:
                             stages.insert(pair.second);
                     }
 
+    /// Count the number of entries holding on to each stage.
+    void            CountStageRefs(UT_Map<UsdStagePtr,exint>& counts) const
+                    {
+                        for(const auto& pair : _map)
+                            ++counts[pair.second];
+                    }
+
+    /// Remove all entries holding on to any of \p stages.
+    void            RemoveStages(const UT_Set<UsdStagePtr>& stages)
+                    {
+                        UT_Array<SdfPath> keysToRemove;
+                        for(const auto& pair : _map) {
+                            if(stages.contains(pair.second))
+                                keysToRemove.append(pair.first);
+                        }
+                        for(const auto& key : keysToRemove)
+                            _map.erase(key);
+                    }
+
     /// Load a range of [start,end) prims from this cache. The range corresponds
     /// to a *subset* of the prims in \p primPaths.
     /// The \p rangeFn functor must implement `operator()(exint)` which, given
@@ -330,10 +368,32 @@ private:
 class GusdStageCache::_Impl
 {
 public:
+    _Impl();
     ~_Impl();
 
     UT_RWLock&      GetMapLock()    { return _mapLock; }
 
+    /// Memory budget accounting.
+    /// Stages are recorded as they are opened, and touched whenever they
+    /// are looked up. Each cache reader starts a new use period, so that
+    /// touching a stage doesn't need to bump a shared counter per lookup.
+    /// The memory of recorded stages is only estimated when the cache is
+    /// trimmed, so opening a stage never pays for a traversal.
+    /// @{
+    void            SetMemoryBudget(int64 bytes)
+                    { _memoryBudget.store(bytes); }
+    int64           GetMemoryBudget() const
+                    { return _memoryBudget.load(); }
+    int64           GetMemoryUsage() const
+                    { return _memoryUsage.load(); }
+
+    void            BeginUsePeriod()
+                    { _useClock.add(1); }
+
+    void            RecordStage(const UsdStageRefPtr& stage);
+    void            TouchStage(const UsdStagePtr& stage) const;
+    /// @}
+
     /// Methods accessible to GusdStageCacheReader.
     /// These require only a shared lock to the stage.
 
@@ -412,6 +472,9 @@ public:
     void            Clear(bool propagateDirty=false);
     void            Clear(const UT_StringSet& paths, bool propagateDirty=false);
 
+    /// Evict unreferenced stages until the cache is within its memory budget.
+    void            Trim(bool propagateDirty=false);
+
     void            AddDataCache(GusdUSD_DataCache& cache)
                     {
                         UT_AutoLock lock(_dataCacheLock);
@@ -498,6 +561,29 @@ private:
                              std::shared_ptr<_StageChangeMicroNode>,
                              _StageHashCmp>;
 
+    struct _StageUsage
+    {
+        _StageUsage(int64 lastUse)
+            : _cost(-1), _lastUse(lastUse) {}
+
+        /// Estimated memory of the stage, or -1 until it is estimated by
+        /// the next trim.
+        int64                   _cost;
+        mutable SYS_AtomicInt64 _lastUse;
+    };
+
+    using _UsageMap =
+        UT_ConcurrentHashMap<UsdStagePtr,
+                             std::shared_ptr<_StageUsage>,
+                             _StageHashCmp>;
+
+    /// Remove usage records for \p stages, updating the memory estimate.
+    void            _ForgetStages(const UT_Set<UsdStagePtr>& stages);
+
+    /// Estimate the memory of stages recorded since the last trim.
+    /// Caller must have an exclusive map lock.
+    void            _EstimateNewStages();
+
     /// Mutex around the concurrent maps.
     /// An exclusive lock must be acquired when iterating over the maps.
     UT_RWLock   _mapLock;
@@ -513,11 +599,27 @@ private:
 
     /// Cache of micro nodes for layers (created on request only).
     _MicroNodeMap _microNodeMap;
+
+    /// Memory estimates and last use of stages opened while a memory
+    /// budget was set.
+    _UsageMap               _usageMap;
+    SYS_AtomicInt64         _memoryBudget;
+    SYS_AtomicInt64         _memoryUsage;
+    mutable SYS_AtomicInt64 _useClock;
     
     UT_Array<GusdUSD_DataCache*> _dataCaches;
 };
 
 
+GusdStageCache::_Impl::_Impl()
+    : _memoryBudget(int64(TfGetEnvSetting(GUSD_STAGECACHE_MEMORY_BUDGET))
+                    * 1024 * 1024),
+      _memoryUsage(0),
+      _useClock(0)
+{
+}
+
+
 GusdStageCache::_Impl::~_Impl()
 {
     // Clear entries, but don't propagate dirty states, as we
@@ -818,8 +920,10 @@ GusdStageCache::_Impl::FindStage(const UT_StringRef& path,
     UT_ASSERT_P(path);
 
     _StageMap::const_accessor a;
-    if(_stageMap.find(a, _StageKey(UTmakeUnsafeRef(path), opts, edit)))
+    if(_stageMap.find(a, _StageKey(UTmakeUnsafeRef(path), opts, edit))) {
+        TouchStage(a->second);
         return a->second;
+    }
 
     return TfNullPtr;
 }
@@ -857,6 +961,13 @@ GusdStageCache::_Impl::FindOrOpenStage(const UT_StringRef& path,
             _stageMap.erase(a);
             return TfNullPtr;
         }
+
+        // Record the new stage after releasing the accessor, so other
+        // lookups of the same key aren't held up.
+        UsdStageRefPtr stage = a->second;
+        a.release();
+        RecordStage(stage);
+        return stage;
     }
     return a->second;
 }
@@ -959,10 +1070,50 @@ GusdStageCache::_Impl::_GetPrimsInRange(const PrimRangeFn& rangeFn,
                                         UsdPrim* prims,
                                         UT_ErrorSeverity sev)
 {
-    // XXX: Could do this in parallel, but profiling suggests it's not worth it.
-
     UT_AutoInterrupt task("Get prims from stage");
 
+    // Prim lookups are cheap, so only split them across threads when there
+    // are enough of them to pay for the threading overhead.
+    if(end - start >= TfGetEnvSetting(GUSD_STAGECACHE_PARALLEL_PRIMS_THRESHOLD)) {
+        std::atomic_bool workerInterrupt(false);
+        GusdErrorTransport errTransport;
+
+        UTparallelFor(
+            UT_BlockedRange<exint>(start, end, 1024),
+            [&](const UT_BlockedRange<exint>& r)
+            {
+                GusdAutoErrorTransport autoErrTransport(errTransport);
+
+                auto* boss = UTgetInterrupt();
+                char bcnt = 0;
+
+                for(exint i = r.begin(); i < r.end(); ++i) {
+                    if(ARCH_UNLIKELY(!++bcnt &&
+                                     (boss->opInterrupt() ||
+                                      workerInterrupt))) {
+                        return;
+                    }
+
+                    exint primIndex = rangeFn(i);
+                    UT_ASSERT_P(primIndex >= 0 &&
+                                primIndex < primPaths.size());
+
+                    const SdfPath& primPath = primPaths(primIndex);
+                    if(!primPath.IsEmpty()) {
+                        prims[primIndex] = GusdUSD_Utils::GetPrimFromStage(
+                            stage, primPath, sev);
+                        if(!prims[primIndex] && sev >= UT_ERROR_ABORT) {
+                            // Interrupt the other worker threads.
+                            workerInterrupt = true;
+                            return;
+                        }
+                    }
+                }
+            });
+
+        return !task.wasInterrupted() && !workerInterrupt;
+    }
+
     char bcnt = 0;
 
     for(exint i = start; i < end; ++i) {
@@ -1326,6 +1477,9 @@ GusdStageCache::_Impl::Clear(bool propagateDirty)
         delete pair.second;
     _maskedCacheMap.clear();
 
+    _usageMap.clear();
+    _memoryUsage.store(0);
+
     {
         UT_AutoLock lock(_dataCacheLock);
         for(auto* cache : _dataCaches) {
@@ -1372,6 +1526,13 @@ GusdStageCache::_Impl::Clear(const UT_StringSet& paths, bool propagateDirty)
     for(const auto& key : keysToRemove)
         _maskedCacheMap.erase(key);
 
+    {
+        UT_Set<UsdStagePtr> stagePtrs;
+        for(const UsdStageRefPtr& stage : stagesBeingRemoved)
+            stagePtrs.insert(stage);
+        _ForgetStages(stagePtrs);
+    }
+
     // Update and clear micro nodes.
     for(const UsdStageRefPtr& stage : stagesBeingRemoved) {
 
@@ -1395,6 +1556,191 @@ GusdStageCache::_Impl::Clear(const UT_StringSet& paths, bool propagateDirty)
 }
 
 
+namespace {
+
+/// Rough cost of each composed prim, on top of the layer sizes.
+constexpr int64 _theBytesPerPrim = 2048;
+
+int64
+_EstimateStageMemory(const UsdStageRefPtr& stage)
+{
+    int64 bytes = 0;
+
+    for(const SdfLayerHandle& layer : stage->GetUsedLayers()) {
+        const std::string& realPath = layer->GetRealPath();
+        if(!realPath.empty()) {
+            const int64_t length = ArchGetFileLength(realPath.c_str());
+            if(length > 0)
+                bytes += length;
+        }
+    }
+
+    int64 numPrims = 0;
+    for(const UsdPrim& prim : stage->TraverseAll()) {
+        TF_UNUSED(prim);
+        ++numPrims;
+    }
+    return bytes + numPrims * _theBytesPerPrim;
+}
+
+} /*namespace*/
+
+
+void
+GusdStageCache::_Impl::RecordStage(const UsdStageRefPtr& stage)
+{
+    // Usage is only worth tracking when there is a budget to enforce.
+    if(!stage || _memoryBudget.load() <= 0)
+        return;
+
+    _UsageMap::accessor a;
+    if(_usageMap.insert(a, stage))
+        a->second = std::make_shared<_StageUsage>(_useClock.load());
+}
+
+
+void
+GusdStageCache::_Impl::_EstimateNewStages()
+{
+    // XXX: Caller should have an exclusive map lock!
+
+    for(auto& pair : _usageMap) {
+        _StageUsage& usage = *pair.second;
+        if(usage._cost >= 0 || !pair.first)
+            continue;
+
+        usage._cost = _EstimateStageMemory(UsdStageRefPtr(pair.first));
+        _memoryUsage.add(usage._cost);
+
+        TF_DEBUG(GUSD_STAGECACHE).Msg(
+            "[GusdStageCache] Estimated %s at %lld bytes\n",
+            UsdDescribe(pair.first).c_str(), (long long)usage._cost);
+    }
+}
+
+
+void
+GusdStageCache::_Impl::TouchStage(const UsdStagePtr& stage) const
+{
+    _UsageMap::const_accessor a;
+    if(_usageMap.find(a, stage))
+        a->second->_lastUse.store(_useClock.load());
+}
+
+
+void
+GusdStageCache::_Impl::_ForgetStages(const UT_Set<UsdStagePtr>& stages)
+{
+    for(const UsdStagePtr& stage : stages) {
+        _UsageMap::accessor a;
+        if(_usageMap.find(a, stage)) {
+            if(a->second->_cost > 0)
+                _memoryUsage.add(-a->second->_cost);
+            _usageMap.erase(a);
+        }
+    }
+}
+
+
+void
+GusdStageCache::_Impl::Trim(bool propagateDirty)
+{
+    // XXX: Caller should have an exclusive map lock!
+
+    const int64 budget = _memoryBudget.load();
+    if(budget <= 0)
+        return;
+
+    _EstimateNewStages();
+
+    int64 usage = _memoryUsage.load();
+    if(usage <= budget)
+        return;
+
+    // Count the references the cache itself holds on each stage, so we
+    // can tell which stages are also referenced from outside the cache.
+    UT_Map<UsdStagePtr,exint> cacheRefs;
+    for(const auto& pair : _stageMap)
+        ++cacheRefs[pair.second];
+    for(const auto& pair : _maskedCacheMap)
+        pair.second->CountStageRefs(cacheRefs);
+
+    struct _Candidate
+    {
+        UsdStagePtr stage;
+        int64       lastUse;
+        int64       cost;
+    };
+    UT_Array<_Candidate> candidates;
+    for(const auto& pair : _usageMap) {
+        candidates.append({pair.first, pair.second->_lastUse.load(),
+                           SYSmax(pair.second->_cost, int64(0))});
+    }
+    std::sort(candidates.begin(), candidates.end(),
+              [](const _Candidate& a, const _Candidate& b)
+              { return a.lastUse < b.lastUse; });
+
+    UT_Set<UsdStagePtr> stagesToEvict;
+    for(const _Candidate& candidate : candidates) {
+        if(usage <= budget)
+            break;
+        if(!candidate.stage) {
+            // Stages that have already been destroyed just need their
+            // usage records dropped.
+            stagesToEvict.insert(candidate.stage);
+            usage -= candidate.cost;
+            continue;
+        }
+
+        auto it = cacheRefs.find(candidate.stage);
+        const exint numCacheRefs = (it != cacheRefs.end()) ? it->second : 0;
+        if(candidate.stage->GetCurrentCount() > numCacheRefs)
+            continue;
+
+        TF_DEBUG(GUSD_STAGECACHE).Msg(
+            "[GusdStageCache::Trim] Evicting %s\n",
+            UsdDescribe(candidate.stage).c_str());
+
+        stagesToEvict.insert(candidate.stage);
+        usage -= candidate.cost;
+    }
+
+    if(stagesToEvict.empty())
+        return;
+
+    UT_Array<_StageKey> keysToRemove;
+    for(const auto& pair : _stageMap) {
+        if(stagesToEvict.contains(pair.second))
+            keysToRemove.append(pair.first);
+    }
+    for(const auto& key : keysToRemove)
+        _stageMap.erase(key);
+    for(auto& pair : _maskedCacheMap)
+        pair.second->RemoveStages(stagesToEvict);
+
+    for(const UsdStagePtr& stage : stagesToEvict) {
+        if(propagateDirty) {
+            _MicroNodeMap::accessor a;
+            if(_microNodeMap.find(a, stage)) {
+                a->second->SetDirty();
+            }
+        }
+        _microNodeMap.erase(stage);
+    }
+    _ForgetStages(stagesToEvict);
+
+    // The evicted stages are gone now, so data caches only need to drop
+    // their entries for expired prims.
+    {
+        UT_AutoLock lock(_dataCacheLock);
+        for(auto* cache : _dataCaches) {
+            UT_ASSERT_P(cache);
+            cache->Clear(UT_StringSet());
+        }
+    }
+}
+
+
 void
 GusdStageCache::_Impl::FindStages(const UT_StringSet& paths,
                                   UT_Set<UsdStageRefPtr>& stages) const
@@ -1438,8 +1784,10 @@ GusdStageCache::_MaskedStageCache::FindStage(const SdfPath& primPath)
     UT_ASSERT_P(_IsValidPrimPath(primPath));
 
     _StageMap::const_accessor ancestorAcc; 
-    if(_map.find(ancestorAcc, primPath))
+    if(_map.find(ancestorAcc, primPath)) {
+        _stageCache.TouchStage(ancestorAcc->second);
         return ancestorAcc->second;
+    }
 
     // The cache holds a map of primPath->stage. When a prim is loaded
     // with masking, all of its descendant prims are fully loaded.
@@ -1460,6 +1808,8 @@ GusdStageCache::_MaskedStageCache::FindStage(const SdfPath& primPath)
                 // We don't always store a new entry because that might
                 // flood the cache, harming rather than improving lookups.   
 
+                _stageCache.TouchStage(ancestorAcc->second);
+
                 const int maxSearchDistance = 4; // Non-scientific guess.
                 if(distanceToMatchingAncestor > maxSearchDistance) {
                     _StageMap::accessor primAcc;
@@ -1527,6 +1877,11 @@ GusdStageCache::_MaskedStageCache::FindOrOpenStage(const SdfPath& primPath,
 
         UT_ASSERT_P(loadedFullStage);
         *loadedFullStage = (a->second->GetPopulationMask() == maskAll);
+
+        UsdStageRefPtr stage = a->second;
+        a.release();
+        _stageCache.RecordStage(stage);
+        return stage;
     }
     return a->second;
 }
@@ -1671,6 +2026,8 @@ GusdStageCache::_MaskedStageCache::LoadPrimRange(
                           std::move(primPathsForBatchedLoad)),
                       SdfPath(), sev)) {
 
+            _stageCache.RecordStage(stage);
+
             // Get all prims in the range.
             for(exint i = 0; i < primIndicesForBatchedLoad.size(); ++i) {
                 exint primIndex = primIndicesForBatchedLoad(i);
@@ -1831,6 +2188,27 @@ GusdStageCache::RemoveDataCache(GusdUSD_DataCache& cache)
 }
 
 
+void
+GusdStageCache::SetMemoryBudget(int64 bytes)
+{
+    _impl->SetMemoryBudget(bytes);
+}
+
+
+int64
+GusdStageCache::GetMemoryBudget() const
+{
+    return _impl->GetMemoryBudget();
+}
+
+
+int64
+GusdStageCache::GetMemoryUsage() const
+{
+    return _impl->GetMemoryUsage();
+}
+
+
 GusdStageCacheReader::GusdStageCacheReader(GusdStageCache& cache, bool writer)
     : _cache(cache), _writer(writer)
 {
@@ -1843,6 +2221,8 @@ GusdStageCacheReader::GusdStageCacheReader(GusdStageCache& cache, bool writer)
         _cache._impl->GetMapLock().writeLock();
     else
         _cache._impl->GetMapLock().readLock();
+
+    _cache._impl->BeginUsePeriod();
 }
 
 
@@ -2036,4 +2416,19 @@ GusdStageCacheWriter::ReloadStages(const UT_StringSet& paths)
     GusdStageCache::ReloadStages(stagePtrs);
 }
 
+
+void
+GusdStageCacheWriter::Trim()
+{
+    // Evicting stages dirties their micro nodes, which is only safe on
+    // the main thread, outside of cooks.
+    if(!UT_Thread::isMainThread()) {
+        TF_WARN("Trimming the USD stage cache on a secondary thread. "
+                "Stages can only be evicted from within Houdini's main "
+                "thread, outside of cooks.");
+        return;
+    }
+    _cache._impl->Trim(/*propagateDirty*/ true);
+}
+
 PXR_NAMESPACE_CLOSE_SCOPE
@@ -101,6 +101,29 @@ public:
     void    RemoveDataCache(GusdUSD_DataCache& cache);
     /// @}
 
+    /// \section GusdStageCache_MemoryBudget Memory Budget
+    ///
+    /// When a memory budget is set, the cache keeps track of the stages it
+    /// opens. GusdStageCacheWriter::Trim() estimates the memory used by
+    /// each of them, based on the size of the stage's layers plus a fixed
+    /// cost per prim, and evicts the least recently used stages that are
+    /// not referenced outside of the cache until the estimate is within
+    /// the budget. Stages are never evicted automatically, since evicting
+    /// a stage dirties its micro nodes; Trim() should be called from the
+    /// main thread, outside of cooks.
+    /// A budget of zero (the default, unless GUSD_STAGECACHE_MEMORY_BUDGET
+    /// is set) disables the tracking and trimming. Stages opened before a
+    /// budget was set are not counted.
+    /// @{
+    void    SetMemoryBudget(int64 bytes);
+
+    int64   GetMemoryBudget() const;
+
+    /// Estimated memory used by the stages counted against the budget,
+    /// as of the last trim.
+    int64   GetMemoryUsage() const;
+    /// @}
+
     /// \section GusdStageCache_Reloading Reloading
     ///
     /// Stages and layers may be reloaded during an active session, but it's
@@ -379,6 +402,14 @@ public:
 
     /// Reload all stages matching the given paths.
     void    ReloadStages(const UT_StringSet& paths);
+
+    /// Evict least recently used stages, including masked stages, until the
+    /// estimated memory use of the cache is within its memory budget
+    /// (see \ref GusdStageCache_MemoryBudget). Stages that are referenced
+    /// outside of the cache are never evicted. The micro nodes of evicted
+    /// stages are dirtied, so the same caveats as for Clear() apply, and
+    /// nothing is evicted when this is called from a secondary thread.
+    void    Trim();
 };
 
 
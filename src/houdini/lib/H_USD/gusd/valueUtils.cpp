@@ -720,6 +720,45 @@ struct _UsdValuesToGroupAttr<
 // --------------------------------------------------
 
 
+/// Invoke @a writeArray(o, gaArray) for each offset of @a range of the
+/// numeric array attr @a attr, in parallel. Each thread is given its own
+/// scratch array to write through.
+/// Returns false if interrupted.
+template <class GaScalarType, class WriteFn>
+bool
+_ParallelWriteNumericArrays(GA_Attribute& attr,
+                            const GA_Range& range,
+                            const WriteFn& writeArray)
+{
+    UT_AutoInterrupt task("Write USD values to numeric array attr");
+
+    // Array storage is paged. Harden all pages up front so that threads
+    // writing to disjoint pages never share (or need to unshare) a page.
+    attr.hardenAllPages();
+
+    UTparallelForLightItems(
+        GA_SplittableRange(range),
+        [&](const GA_SplittableRange& r)
+        {
+            _InterruptPoll interrupt;
+
+            UT_Array<GaScalarType> gaArray;
+
+            GA_Offset o, end;
+            for (GA_Iterator it(r); it.blockAdvance(o,end); ) {
+                if (interrupt()) {
+                    return;
+                }
+
+                for ( ; o < end; ++o) {
+                    writeArray(o, gaArray);
+                }
+            }
+        });
+    return !task.wasInterrupted();
+}
+
+
 template <class T, class U=void>
 struct _UsdValuesToNumericArrayAttr
 {
@@ -756,21 +795,10 @@ struct _UsdValuesToNumericArrayAttr<
             return false;
         }
 
-        UT_AutoInterrupt task("Write USD values to numeric array attr");
-
-        // TODO: Can this be done in parallel?
-
-        _InterruptPoll interrupt;
-
-        UT_Array<GaScalarType> gaArray;
-
-        GA_Offset o, end;
-        for (GA_Iterator it(range); it.blockAdvance(o,end); ) {
-            if (interrupt()) {
-                return false;
-            }
-
-            for ( ; o < end; ++o) {
+        return _ParallelWriteNumericArrays<GaScalarType>(
+            attr, range,
+            [&](GA_Offset o, UT_Array<GaScalarType>& gaArray)
+            {
                 const T& value = values[rangeIndices[o]];
 
                 // XXX: Using unsafeShareData to avoid an extract copy.
@@ -784,9 +812,7 @@ struct _UsdValuesToNumericArrayAttr<
                 aif->set(&attr, o, gaArray);
 
                 gaArray.unsafeClearData();
-            }
-        }
-        return true;
+            });
     }
 };
 
@@ -818,21 +844,10 @@ struct _UsdValuesToNumericArrayAttr<
             return false;
         }
 
-        UT_AutoInterrupt task("Write USD values to numeric array attr");
-
-        // TODO: Can this be done in parallel?
-
-        _InterruptPoll interrupt;
-
-        UT_Array<GaScalarType> gaArray;
-
-        GA_Offset o, end;
-        for (GA_Iterator it(range); it.blockAdvance(o,end); ) {
-            if (interrupt()) {
-                return false;
-            }
-
-            for ( ; o < end; ++o) {
+        return _ParallelWriteNumericArrays<GaScalarType>(
+            attr, range,
+            [&](GA_Offset o, UT_Array<GaScalarType>& gaArray)
+            {
                 const T& value = values[rangeIndices[o]];
 
                 const size_t numScalars = Traits::GetNumScalars(value);
@@ -844,9 +859,7 @@ struct _UsdValuesToNumericArrayAttr<
                 }
 
                 aif->set(&attr, o, gaArray);
-            }
-        }
-        return true;
+            });
     }
 };
             
@@ -210,6 +210,13 @@ _ReloadStages(GusdStageCache& self, const list& paths)
 }
 
 
+void
+_Trim(GusdStageCache& self)
+{
+    GusdStageCacheWriter(self).Trim();
+}
+
+
 void wrapGusdStageCache()
 {
     using This = GusdStageCache;
@@ -257,5 +264,13 @@ void wrapGusdStageCache()
         .def("FindStages", &_FindStages, (arg("paths")))
 
         .def("ReloadStages", &_ReloadStages, (arg("paths")))
+
+        .def("SetMemoryBudget", &This::SetMemoryBudget, (arg("bytes")))
+
+        .def("GetMemoryBudget", &This::GetMemoryBudget)
+
+        .def("GetMemoryUsage", &This::GetMemoryUsage)
+
+        .def("Trim", &_Trim)
         ;
 }